@@ -309,6 +309,60 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Send several messages at once (non-blocking).
+ *
+ * Delivers up to @p num messages from @p m to @p target_pid with interrupts
+ * disabled only once. If the target is waiting in msg_receive() or
+ * msg_receive_bulk() the first message is handed over directly, the others
+ * are put into the target's message queue. Delivery stops at the first
+ * message that does not fit into the queue.
+ *
+ * The target is scheduled at most once, so a burst of messages is processed
+ * with a single context switch if the target uses msg_receive_bulk().
+ *
+ * Can be called from interrupt context.
+ *
+ * @param[in] m             Array of @p num messages, the ``sender_pid``
+ *                          fields are overwritten. Must not be NULL.
+ * @param[in] num           Number of messages in @p m
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  Number of messages delivered (the first ones of @p m)
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
+/**
+ * @brief Receive several messages at once.
+ *
+ * Blocks until at least one message is available, then returns all messages
+ * (up to @p max) that are queued for or being sent to the calling thread,
+ * oldest first. Compared to calling msg_receive() repeatedly, the message
+ * queue is drained with interrupts disabled once and the calling thread is
+ * woken up only once per burst of messages.
+ *
+ * @param[out] m    Array of at least @p max preallocated ``msg_t``
+ *                  structures, must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  Number of received messages (1 to @p max)
+ */
+int msg_receive_bulk(msg_t *m, unsigned max);
+
+/**
+ * @brief Try to receive several messages at once.
+ *
+ * Non-blocking variant of msg_receive_bulk().
+ *
+ * @param[out] m    Array of at least @p max preallocated ``msg_t``
+ *                  structures, must not be NULL.
+ * @param[in] max   Maximum number of messages to receive
+ *
+ * @return  Number of received messages (0 to @p max)
+ */
+int msg_try_receive_bulk(msg_t *m, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -11,6 +11,18 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * ## Priority inheritance
+ *
+ * With the (opt-in) module `core_mutex_priority_inheritance` a mutex keeps
+ * track of the thread that currently holds it. When a thread of higher
+ * priority blocks on the mutex, the owner temporarily runs at the priority of
+ * that waiter until it unlocks the mutex. This bounds priority inversion to
+ * the length of the critical section (see tests/thread_priority_inversion).
+ * The boost is passed on along a chain of owners waiting for other mutexes,
+ * but not to threads blocked on message queues or mboxes. Each mutex restores
+ * the priority its owner had before that mutex boosted it, so a thread holding
+ * several contended mutexes should unlock them in reverse locking order.
  * @{
  *
  * @file
@@ -25,6 +37,7 @@
 #include <stddef.h>
 
 #include "list.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -40,18 +53,43 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The current owner of the mutex or `KERNEL_PID_UNDEF`
+     * @note    Only available if module core_mutex_priority_inheritance
+     *          is used.
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Priority of the owner before this mutex boosted it, restored
+     *          on unlock
+     * @note    Only available if module core_mutex_priority_inheritance
+     *          is used.
+     * @internal
+     */
+    uint8_t owner_original_priority;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +110,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -127,6 +168,26 @@ void mutex_unlock(mutex_t *mutex);
  */
 void mutex_unlock_and_sleep(mutex_t *mutex);
 
+/**
+ * @brief Removes a thread from the threads waiting for a mutex
+ *
+ * @internal
+ * For implementations of locking with a timeout, e.g.
+ * xtimer_mutex_lock_timeout(). Must be called with interrupts disabled. The
+ * caller has to make the thread runnable again.
+ *
+ * With module core_mutex_priority_inheritance, the owner of the mutex drops
+ * the priority it inherited from the removed thread, keeping the boost the
+ * remaining waiters justify.
+ *
+ * @param[in] mutex Mutex the thread is waiting for, must not be NULL.
+ * @param[in] pid   The waiting thread.
+ *
+ * @return 1 if the thread was waiting for the mutex and got removed.
+ * @return 0 if the thread was not waiting for the mutex.
+ */
+int _mutex_remove_waiter(mutex_t *mutex, kernel_pid_t pid);
+
 #ifdef __cplusplus
 }
 #endif
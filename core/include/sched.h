@@ -119,6 +119,20 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of the given thread
+ *
+ * @details If the thread is on a run queue it is moved to the run queue of
+ *          the new priority. This function does not yield, the caller has to
+ *          trigger a context switch (e.g. via sched_switch() or
+ *          thread_yield_higher()) if the change affects which thread should
+ *          run. It can thus be used with interrupts disabled.
+ *
+ * @param[in]   thread      Thread to change the priority of, must not be NULL
+ * @param[in]   priority    New priority, must be < SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -175,14 +189,47 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @brief   Number of buckets of the wakeup latency histogram
+ *
+ * Bucket 0 counts wakeups that were served within the same tick, bucket
+ * i > 0 counts latencies of [2^(i-1), 2^i) ticks. The last bucket also counts
+ * all longer latencies.
+ */
+#ifndef SCHEDSTAT_LATENCY_BUCKETS
+#define SCHEDSTAT_LATENCY_BUCKETS   (12U)
+#endif
+
 /**
  *  Scheduler statistics
+ *
+ * @note    irq_off_ticks is only measured on CPUs whose irq_disable(),
+ *          irq_enable() and irq_restore() call
+ *          sched_statistics_irq_disabled() and
+ *          sched_statistics_irq_enabled(). Currently these are the Cortex-M
+ *          CPUs only; on all other CPUs it stays 0.
  */
 typedef struct {
     uint32_t laststart;      /**< Time stamp of the last time this thread was
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    uint32_t lastwakeup;     /**< Time stamp of the last time this thread
+                                  became runnable, 0 if it is not waiting
+                                  for the CPU */
+    uint32_t max_burst;      /**< Longest time in ticks the thread ran
+                                  without being switched out */
+    uint32_t irq_off_ticks;  /**< Total time in ticks the thread ran with
+                                  interrupts disabled (Cortex-M only, see
+                                  above) */
+    unsigned int preemptions;   /**< How often the thread was switched out
+                                     while still runnable, without calling
+                                     thread_yield() */
+    uint8_t yielded;         /**< Set by thread_yield() until the thread is
+                                  switched out or continues */
+    uint16_t latency[SCHEDSTAT_LATENCY_BUCKETS];  /**< log2 histogram of the
+                                     time from becoming runnable to running,
+                                     saturating */
 } schedstat;
 
 /**
@@ -196,6 +243,24 @@ extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(uint32_t, uint32_t));
+
+/**
+ * @brief   Start accounting interrupt-disabled time to the active thread
+ *
+ * @internal
+ * To be called by irq_disable() when it actually disables interrupts,
+ * with interrupts already disabled.
+ */
+void sched_statistics_irq_disabled(void);
+
+/**
+ * @brief   Stop accounting interrupt-disabled time to the active thread
+ *
+ * @internal
+ * To be called by irq_enable() and irq_restore() right before they actually
+ * enable interrupts.
+ */
+void sched_statistics_irq_enabled(void);
 #endif /* MODULE_SCHEDSTATISTICS */
 
 #ifdef __cplusplus
@@ -186,11 +186,15 @@ struct _thread {
 #endif
 
     clist_node_t rq_entry;          /**< run queue entry                */
+    list_node_t *wait_group_tail;   /**< last waiter with the same priority
+                                         in a wait list, only valid for the
+                                         first one of them              */
 
 #if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
+    || defined(MODULE_CORE_MBOX) \
+    || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    void *wait_data;                /**< used by msg, mbox, thread flags
+                                         and mutex priority inheritance */
 #endif
 #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
     list_node_t msg_waiters;        /**< threads waiting for their message
@@ -467,16 +471,49 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
  *
  * This will add @p thread to @p list sorted by the thread priority.
  * It reuses the thread's rq_entry field.
- * Used internally by msg and mutex implementations.
+ * Used internally by msg, mbox and mutex implementations.
+ *
+ * Threads of equal priority are kept in FIFO order. As the list keeps track
+ * of the last thread of each priority, this takes at most one step per
+ * priority level present in the list, regardless of the number of threads
+ * in it.
  *
  * @note Only use for threads *not on any runqueue* and with interrupts
- *       disabled.
+ *       disabled. Lists filled by this function must only be modified with
+ *       thread_remove_head_from_list() and thread_remove_from_list().
  *
  * @param[in] list      ptr to list root node
  * @param[in] thread    thread to add
  */
 void thread_add_to_list(list_node_t *list, thread_t *thread);
 
+/**
+ * @brief Remove the first (highest priority) thread from a list filled by
+ *        thread_add_to_list() (internal)
+ *
+ * @note Only use with interrupts disabled.
+ *
+ * @param[in] list      ptr to list root node
+ *
+ * @return  the removed thread's rq_entry field
+ * @return  NULL, if @p list was empty
+ */
+list_node_t *thread_remove_head_from_list(list_node_t *list);
+
+/**
+ * @brief Remove a thread from a list filled by thread_add_to_list()
+ *        (internal)
+ *
+ * @note Only use with interrupts disabled.
+ *
+ * @param[in] list      ptr to list root node
+ * @param[in] thread    thread to remove
+ *
+ * @return  the removed thread's rq_entry field
+ * @return  NULL, if @p thread was not in @p list
+ */
+list_node_t *thread_remove_from_list(list_node_t *list, thread_t *thread);
+
 /**
  * @brief Returns the name of a process
  *
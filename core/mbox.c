@@ -59,7 +59,7 @@ int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking)
 {
     unsigned irqstate = irq_disable();
 
-    list_node_t *next = (list_node_t*) list_remove_head(&mbox->readers);
+    list_node_t *next = (list_node_t*) thread_remove_head_from_list(&mbox->readers);
     if (next) {
         DEBUG("mbox: Thread %"PRIkernel_pid" mbox 0x%08x: _tryput(): "
                 "there's a waiter.\n", sched_active_pid, (unsigned)mbox);
@@ -99,7 +99,7 @@ int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking)
                 "got queued message.\n", sched_active_pid, (unsigned)mbox);
         /* copy msg from queue */
         *msg = mbox->msg_array[cib_get_unsafe(&mbox->cib)];
-        list_node_t *next = (list_node_t*) list_remove_head(&mbox->writers);
+        list_node_t *next = (list_node_t*) thread_remove_head_from_list(&mbox->writers);
         if (next) {
             thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
             _wake_waiter(thread, irqstate);
@@ -37,6 +37,7 @@
 #include "debug.h"
 
 static int _msg_receive(msg_t *m, int block);
+static int _msg_receive_bulk(msg_t *m, unsigned max, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
 static int queue_msg(thread_t *target, const msg_t *m)
@@ -217,6 +218,51 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    assert(pid_is_valid(target_pid));
+
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned state = irq_disable();
+    unsigned sent = 0;
+    int woken = 0;
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        m[0].sender_pid = sender_pid;
+        *((msg_t *)target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        woken = 1;
+        sent++;
+    }
+
+    for (; sent < num; sent++) {
+        m[sent].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[sent])) {
+            break;
+        }
+    }
+
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+
+    DEBUG("msg_send_bulk: %u of %u messages delivered to %" PRIkernel_pid
+          "\n", sent, num, target_pid);
+
+    if (woken) {
+        sched_switch(target_prio);
+    }
+    return sent;
+}
+
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
     assert(sched_active_pid != target_pid);
@@ -315,7 +361,7 @@ static int _msg_receive(msg_t *m, int block)
         me->wait_data = (void *) m;
     }
 
-    list_node_t *next = list_remove_head(&me->msg_waiters);
+    list_node_t *next = thread_remove_head_from_list(&me->msg_waiters);
 
     if (next == NULL) {
         DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive(): No thread in waiting list.\n",
@@ -372,6 +418,83 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_bulk(msg_t *m, unsigned max)
+{
+    return _msg_receive_bulk(m, max, 1);
+}
+
+int msg_try_receive_bulk(msg_t *m, unsigned max)
+{
+    return _msg_receive_bulk(m, max, 0);
+}
+
+static int _msg_receive_bulk(msg_t *m, unsigned max, int block)
+{
+    assert(!block || (max > 0));
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t *) sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    /* queued messages are the oldest ones */
+    if (me->msg_array) {
+        int queue_index;
+        while ((n < max) && ((queue_index = cib_get(&me->msg_queue)) >= 0)) {
+            m[n++] = me->msg_array[queue_index];
+        }
+    }
+
+    /* then take the messages of blocked senders, either directly or (once m
+     * is full) into the just freed queue space, as _msg_receive() does */
+    while (me->msg_waiters.next) {
+        msg_t *dest;
+
+        if (n < max) {
+            dest = &m[n++];
+        }
+        else {
+            int queue_index = me->msg_array ? cib_put(&me->msg_queue) : -1;
+            if (queue_index < 0) {
+                break;
+            }
+            dest = &me->msg_array[queue_index];
+        }
+
+        list_node_t *next = thread_remove_head_from_list(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+
+        *dest = *((msg_t *) sender->wait_data);
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    if ((n == 0) && block) {
+        DEBUG("_msg_receive_bulk(): %" PRIkernel_pid ": No msg in queue. "
+              "Going blocked.\n", sched_active_pid);
+        me->wait_data = (void *) m;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* the sender copied one message, collect what else arrived with it */
+        return 1 + _msg_receive_bulk(m + 1, max - 1, 0);
+    }
+
+    irq_restore(state);
+    DEBUG("_msg_receive_bulk(): %" PRIkernel_pid ": got %u messages\n",
+          sched_active_pid, n);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
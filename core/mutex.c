@@ -32,6 +32,138 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+/* value of mutex_t::owner_original_priority while the mutex did not boost
+ * its owner */
+#define NOT_BOOSTED     (UINT8_MAX)
+
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    /* the mutex may be taken before the scheduler is started */
+    mutex->owner = owner ? owner->pid : KERNEL_PID_UNDEF;
+    mutex->owner_original_priority = NOT_BOOSTED;
+}
+
+/* Changes the priority of thread. Wait lists are sorted by priority (see
+ * thread_add_to_list()), so a thread waiting for a mutex is re-queued. Threads
+ * queued on message queues or mboxes keep their priority.
+ * Returns the mutex thread is waiting for, if any. */
+static mutex_t *_set_priority(thread_t *thread, uint8_t priority)
+{
+    switch (thread->status) {
+        case STATUS_MUTEX_BLOCKED: {
+            mutex_t *blocker = thread->wait_data;
+            thread_remove_from_list(&blocker->queue, thread);
+            thread->priority = priority;
+            thread_add_to_list(&blocker->queue, thread);
+            return blocker;
+        }
+        case STATUS_SEND_BLOCKED:
+        case STATUS_MBOX_BLOCKED:
+            return NULL;
+        default:
+            sched_change_priority(thread, priority);
+            return NULL;
+    }
+}
+
+static void _boost_owner(mutex_t *mutex, thread_t *me)
+{
+    /* follow the chain of owners that are themselves waiting for a mutex.
+     * This terminates, as every boosted thread ends up at a priority not
+     * lower than the priority of me. */
+    while (mutex) {
+        thread_t *owner = (thread_t *)thread_get(mutex->owner);
+        if (!owner || (owner->priority <= me->priority)) {
+            return;
+        }
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", me->pid, owner->pid,
+              (uint32_t)me->priority);
+        if (mutex->owner_original_priority == NOT_BOOSTED) {
+            mutex->owner_original_priority = owner->priority;
+        }
+        mutex = _set_priority(owner, me->priority);
+    }
+}
+
+/* Lowers the owner after a waiter of the given priority left the wait list
+ * of mutex, or was lowered itself, to the priority of the remaining waiters
+ * but not below the one it had before mutex boosted it. Like _boost_owner(),
+ * this follows the chain of owners waiting for a mutex. An owner boosted
+ * above priority by something else keeps its priority. */
+static void _unboost_owner(mutex_t *mutex, uint8_t priority)
+{
+    while (mutex) {
+        thread_t *owner = (thread_t *)thread_get(mutex->owner);
+        uint8_t original = mutex->owner_original_priority;
+        if (!owner || (original == NOT_BOOSTED) ||
+            (owner->priority < priority)) {
+            return;
+        }
+        uint8_t new_priority = original;
+        if ((mutex->queue.next != NULL) &&
+            (mutex->queue.next != MUTEX_LOCKED)) {
+            /* the wait list is sorted by priority */
+            thread_t *head = container_of((clist_node_t *)mutex->queue.next,
+                                          thread_t, rq_entry);
+            if (head->priority < new_priority) {
+                new_priority = head->priority;
+            }
+        }
+        if (new_priority <= owner->priority) {
+            return;
+        }
+        DEBUG("mutex: lowering owner %" PRIkernel_pid " to prio %" PRIu32
+              "\n", owner->pid, (uint32_t)new_priority);
+        if (new_priority == original) {
+            mutex->owner_original_priority = NOT_BOOSTED;
+        }
+        priority = owner->priority;
+        mutex = _set_priority(owner, new_priority);
+    }
+}
+
+static inline int _restore_owner(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+    uint8_t priority = mutex->owner_original_priority;
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner && (priority != NOT_BOOSTED)) {
+        DEBUG("mutex: restoring prio %" PRIu32 " of %" PRIkernel_pid "\n",
+              (uint32_t)priority, owner->pid);
+        _set_priority(owner, priority);
+        return 1;
+    }
+    return 0;
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    (void)mutex;
+    (void)owner;
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *me)
+{
+    (void)mutex;
+    (void)me;
+}
+
+static inline void _unboost_owner(mutex_t *mutex, uint8_t priority)
+{
+    (void)mutex;
+    (void)priority;
+}
+
+static inline int _restore_owner(mutex_t *mutex)
+{
+    (void)mutex;
+    return 0;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +173,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t *)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -52,12 +185,13 @@ int _mutex_lock(mutex_t *mutex, int blocking)
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
-            mutex->queue.next = (list_node_t*)&me->rq_entry;
-            mutex->queue.next->next = NULL;
-        }
-        else {
-            thread_add_to_list(&mutex->queue, me);
+            mutex->queue.next = NULL;
         }
+        thread_add_to_list(&mutex->queue, me);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->wait_data = mutex;
+#endif
+        _boost_owner(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -83,20 +217,32 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    int restored = _restore_owner(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+        if (restored) {
+            /* the previous owner dropped its inherited priority */
+            if (irq_is_in()) {
+                sched_context_switch_request = 1;
+            }
+            else {
+                thread_yield_higher();
+            }
+        }
         return;
     }
 
-    list_node_t *next = list_remove_head(&mutex->queue);
+    list_node_t *next = thread_remove_head_from_list(&mutex->queue);
 
     thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
 
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    _set_owner(mutex, process);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -107,6 +253,20 @@ void mutex_unlock(mutex_t *mutex)
     sched_switch(process_priority);
 }
 
+int _mutex_remove_waiter(mutex_t *mutex, kernel_pid_t pid)
+{
+    thread_t *thread = (thread_t *)thread_get(pid);
+
+    if (!thread || !thread_remove_from_list(&mutex->queue, thread)) {
+        return 0;
+    }
+    if (mutex->queue.next == NULL) {
+        mutex->queue.next = MUTEX_LOCKED;
+    }
+    _unboost_owner(mutex, thread->priority);
+    return 1;
+}
+
 void mutex_unlock_and_sleep(mutex_t *mutex)
 {
     DEBUG("PID[%" PRIkernel_pid "]: unlocking mutex. queue.next: 0x%08x, and "
@@ -114,15 +274,17 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        (void)_restore_owner(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
         else {
-            list_node_t *next = list_remove_head(&mutex->queue);
+            list_node_t *next = thread_remove_head_from_list(&mutex->queue);
             thread_t *process = container_of((clist_node_t*)next, thread_t,
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            _set_owner(mutex, process);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -77,6 +78,23 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 #ifdef MODULE_SCHEDSTATISTICS
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+
+static uint32_t _irq_off_start;
+static bool _irq_off_valid;
+
+static void _account_latency(schedstat *stat, uint32_t now)
+{
+    uint32_t latency = now - stat->lastwakeup;
+    unsigned bucket = latency ? (bitarithm_msb(latency) + 1) : 0;
+
+    if (bucket >= SCHEDSTAT_LATENCY_BUCKETS) {
+        bucket = SCHEDSTAT_LATENCY_BUCKETS - 1;
+    }
+    if (stat->latency[bucket] < UINT16_MAX) {
+        stat->latency[bucket]++;
+    }
+    stat->lastwakeup = 0;
+}
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -96,6 +114,12 @@ int __attribute__((used)) sched_run(void)
           next_thread->pid);
 
     if (active_thread == next_thread) {
+#ifdef MODULE_SCHEDSTATISTICS
+        /* woken up again before it was switched out, or yielded without
+         * another thread to run */
+        sched_pidlist[active_thread->pid].lastwakeup = 0;
+        sched_pidlist[active_thread->pid].yielded = 0;
+#endif
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
         return 0;
     }
@@ -107,7 +131,16 @@ int __attribute__((used)) sched_run(void)
     if (active_thread) {
         if (active_thread->status == STATUS_RUNNING) {
             active_thread->status = STATUS_PENDING;
+#ifdef MODULE_SCHEDSTATISTICS
+            /* switched out while still runnable, but not by thread_yield() */
+            if (!sched_pidlist[active_thread->pid].yielded) {
+                sched_pidlist[active_thread->pid].preemptions++;
+            }
+#endif
         }
+#ifdef MODULE_SCHEDSTATISTICS
+        sched_pidlist[active_thread->pid].yielded = 0;
+#endif
 
 #ifdef SCHED_TEST_STACK
         if (*((uintptr_t *) active_thread->stack_start) != (uintptr_t) active_thread->stack_start) {
@@ -118,13 +151,20 @@ int __attribute__((used)) sched_run(void)
 #ifdef MODULE_SCHEDSTATISTICS
         schedstat *active_stat = &sched_pidlist[active_thread->pid];
         if (active_stat->laststart) {
-            active_stat->runtime_ticks += now - active_stat->laststart;
+            uint32_t burst = now - active_stat->laststart;
+            active_stat->runtime_ticks += burst;
+            if (burst > active_stat->max_burst) {
+                active_stat->max_burst = burst;
+            }
         }
 #endif
     }
 
 #ifdef MODULE_SCHEDSTATISTICS
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
+    if (next_stat->lastwakeup) {
+        _account_latency(next_stat, now);
+    }
     next_stat->laststart = now;
     next_stat->schedules++;
     if (sched_cb) {
@@ -156,6 +196,24 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 {
     sched_cb = callback;
 }
+
+void sched_statistics_irq_disabled(void)
+{
+    /* time spent in ISRs and before the scheduler started is not accounted */
+    _irq_off_valid = (sched_active_thread != NULL) && !irq_is_in();
+    if (_irq_off_valid) {
+        _irq_off_start = _xtimer_lltimer_now();
+    }
+}
+
+void sched_statistics_irq_enabled(void)
+{
+    if (_irq_off_valid && sched_active_thread) {
+        uint32_t off = _xtimer_lltimer_mask(_xtimer_lltimer_now() - _irq_off_start);
+        sched_pidlist[sched_active_pid].irq_off_ticks += off;
+    }
+    _irq_off_valid = false;
+}
 #endif
 
 void sched_set_status(thread_t *process, unsigned int status)
@@ -166,6 +224,11 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDSTATISTICS
+            if (sched_active_thread) {
+                sched_pidlist[process->pid].lastwakeup = xtimer_now().ticks32;
+            }
+#endif
         }
     }
     else {
@@ -183,6 +246,33 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(thread && (priority < SCHED_PRIO_LEVELS));
+
+    unsigned irq_state = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irq_state);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " %" PRIu8 " -> %"
+          PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irq_state);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -103,6 +103,10 @@ void thread_yield(void)
     if (me->status >= STATUS_ON_RUNQUEUE) {
         clist_lpoprpush(&sched_runqueues[me->priority]);
     }
+#ifdef MODULE_SCHEDSTATISTICS
+    /* a voluntary switch, not a preemption */
+    sched_pidlist[me->pid].yielded = 1;
+#endif
     irq_restore(old_state);
 
     thread_yield_higher();
@@ -114,17 +118,71 @@ void thread_add_to_list(list_node_t *list, thread_t *thread)
 
     uint16_t my_prio = thread->priority;
     list_node_t *new_node = (list_node_t*)&thread->rq_entry;
+    thread_t *group = NULL;
 
+    /* skip whole groups of waiters with the same priority, so this loop runs
+     * at most once per priority level, not once per waiter */
     while (list->next) {
         thread_t *list_entry = container_of((clist_node_t*)list->next, thread_t, rq_entry);
         if (list_entry->priority > my_prio) {
             break;
         }
-        list = list->next;
+        group = list_entry;
+        list = group->wait_group_tail;
     }
 
     new_node->next = list->next;
     list->next = new_node;
+
+    if (group && (group->priority == my_prio)) {
+        group->wait_group_tail = new_node;
+    }
+    else {
+        thread->wait_group_tail = new_node;
+    }
+}
+
+list_node_t *thread_remove_head_from_list(list_node_t *list)
+{
+    list_node_t *head = list_remove_head(list);
+
+    if (head) {
+        thread_t *thread = container_of((clist_node_t*)head, thread_t, rq_entry);
+        if (thread->wait_group_tail != head) {
+            /* next waiter has the same priority, it now heads the group */
+            thread_t *next = container_of((clist_node_t*)list->next, thread_t, rq_entry);
+            next->wait_group_tail = thread->wait_group_tail;
+        }
+    }
+    return head;
+}
+
+list_node_t *thread_remove_from_list(list_node_t *list, thread_t *thread)
+{
+    list_node_t *node = (list_node_t*)&thread->rq_entry;
+    thread_t *group = NULL;
+
+    while (list->next && (list->next != node)) {
+        thread_t *list_entry = container_of((clist_node_t*)list->next, thread_t, rq_entry);
+        if (!group || (group->priority != list_entry->priority)) {
+            group = list_entry;
+        }
+        list = list->next;
+    }
+
+    if (!list->next) {
+        return NULL;
+    }
+
+    if (group && (group->priority == thread->priority)) {
+        /* thread is within a group */
+        if (group->wait_group_tail == node) {
+            group->wait_group_tail = list;
+        }
+        list->next = node->next;
+        return node;
+    }
+    return thread_remove_head_from_list(list);
 }
 
 #ifdef DEVELHELP
@@ -143,15 +143,15 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
     return -ENOTCONN;
 }
 
-int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                  uint32_t timeout, sock_udp_ep_t *remote)
+/* waits for a packet, on success sock->mutex is held and its length is
+ * returned */
+static int _recv(sock_udp_t *sock, uint32_t timeout, sock_udp_ep_t *remote)
 {
     xtimer_t timeout_timer;
     int blocking = BLOCKING;
     int res = -EIO;
     msg_t msg;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->sock.input_callback == NULL) {
         return -EADDRNOTAVAIL;
     }
@@ -178,12 +178,6 @@ int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
             break;
         case _MSG_TYPE_RCV:
             mutex_lock(&sock->mutex);
-            if (max_len < sock->recv_info.datalen) {
-                res = -ENOBUFS;
-                mutex_unlock(&sock->mutex);
-                break;
-            }
-            memcpy(data, sock->recv_info.data, sock->recv_info.datalen);
             if (remote != NULL) {
                 remote->family = AF_INET6;
                 remote->netif = SOCK_ADDR_ANY_NETIF;
@@ -191,13 +185,61 @@ int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                 remote->port = sock->recv_info.src_port;
             }
             res = (int)sock->recv_info.datalen;
-            mutex_unlock(&sock->mutex);
             break;
     }
     atomic_fetch_sub(&sock->receivers, 1);
     return res;
 }
 
+int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                  uint32_t timeout, sock_udp_ep_t *remote)
+{
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    if ((res = _recv(sock, timeout, remote)) < 0) {
+        return res;
+    }
+    if (max_len < (size_t)res) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, sock->recv_info.data, res);
+    }
+    mutex_unlock(&sock->mutex);
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* emb6 keeps the data in its own buffer, so only let it deliver the
+         * next packet again */
+        mutex_unlock(&sock->mutex);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+    if ((res = _recv(sock, timeout, remote)) < 0) {
+        return res;
+    }
+    if (res == 0) {
+        mutex_unlock(&sock->mutex);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+    /* sock->mutex stays locked until the data is released, so emb6 can't
+     * overwrite sock->recv_info with the next packet meanwhile */
+    *data = (void *)sock->recv_info.data;
+    *buf_ctx = sock;
+    return res;
+}
+
 int sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                   const sock_udp_ep_t *remote)
 {
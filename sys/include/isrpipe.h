@@ -25,7 +25,11 @@
 #include <stdint.h>
 
 #include "mutex.h"
+#ifdef MODULE_LFRING
+#include "lfring.h"
+#else
 #include "tsrb.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,14 +39,22 @@ extern "C" {
  * @brief   Context structure for isrpipe
  */
 typedef struct {
-    tsrb_t tsrb;        /**< isrpipe thread safe ringbuffer */
+#ifdef MODULE_LFRING
+    lfring_t rb;        /**< isrpipe lock-free ring buffer */
+#else
+    tsrb_t rb;          /**< isrpipe thread safe ringbuffer */
+#endif
     mutex_t mutex;      /**< isrpipe mutex */
 } isrpipe_t;
 
 /**
  * @brief   Static initializer for irspipe
  */
-#define ISRPIPE_INIT(tsrb_buf) { .mutex = MUTEX_INIT, .tsrb = TSRB_INIT(tsrb_buf) }
+#ifdef MODULE_LFRING
+#define ISRPIPE_INIT(buf) { .mutex = MUTEX_INIT, .rb = LFRING_INIT(buf) }
+#else
+#define ISRPIPE_INIT(buf) { .mutex = MUTEX_INIT, .rb = TSRB_INIT(buf) }
+#endif
 
 /**
  * @brief   Initialisation function for isrpipe
@@ -64,6 +76,21 @@ void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, char c);
 
+/**
+ * @brief   Put several characters into the isrpipe's buffer
+ *
+ * The characters are copied in (at most) two contiguous chunks and a waiting
+ * reader is woken up once.
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         characters to add to isrpipe buffer
+ * @param[in]   count       number of characters in @p buf
+ *
+ * @returns     number of characters added, less than @p count if the buffer
+ *              was full
+ */
+int isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
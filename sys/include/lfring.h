@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_lfring Lock-free ring buffers
+ * @ingroup     sys
+ * @brief       Lock-free byte and pointer ring buffers
+ *
+ * The ring buffers of this module can be shared between a consumer and
+ * producers running in other threads or in ISRs without any locking:
+ *
+ * | type              | elements | producers | consumers |
+ * |-------------------|----------|-----------|-----------|
+ * | @ref lfring_t     | bytes    | 1         | 1         |
+ * | @ref lfring_ptr_t | pointers | 1         | 1         |
+ * | @ref lfring_mpsc_t| pointers | any       | 1         |
+ *
+ * Unlike @ref sys_tsrb, the bulk functions of the single producer rings copy
+ * whole contiguous spans using `memcpy()`, i.e. at most two copies per call.
+ * The peek/commit functions give direct access to those spans, so data can be
+ * produced or consumed in place without an intermediate buffer.
+ *
+ * The multi producer ring stores a sequence number with every slot, so
+ * producers never wait for each other (a producer interrupted by another one
+ * just delays the visibility of its own element). There is no multi producer
+ * byte ring, as bytes of concurrent writers would interleave arbitrarily.
+ *
+ * @attention   Buffer sizes (in elements) must be a power of two!
+ *
+ * @note        The ring buffers are built on C11 `<stdatomic.h>`, which is not
+ *              available on AVR and MSP430. @ref isr_pipe falls back to
+ *              @ref sys_tsrb on these platforms.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ring buffer interface definition
+ */
+
+#ifndef LFRING_H
+#define LFRING_H
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Single producer, single consumer byte ring buffer
+ */
+typedef struct {
+    uint8_t *buf;               /**< Buffer to operate on */
+    unsigned size;              /**< Size of buffer, must be power of 2 */
+    atomic_uint reads;          /**< total number of reads */
+    atomic_uint writes;         /**< total number of writes */
+} lfring_t;
+
+/**
+ * @brief   Single producer, single consumer pointer ring buffer
+ */
+typedef struct {
+    void **buf;                 /**< Buffer to operate on */
+    unsigned size;              /**< Number of pointers in buffer, must be
+                                     power of 2 */
+    atomic_uint reads;          /**< total number of reads */
+    atomic_uint writes;         /**< total number of writes */
+} lfring_ptr_t;
+
+/**
+ * @brief   Slot of a @ref lfring_mpsc_t
+ */
+typedef struct {
+    atomic_uint seq;            /**< sequence number of the slot */
+    void *ptr;                  /**< stored pointer */
+} lfring_mpsc_slot_t;
+
+/**
+ * @brief   Multi producer, single consumer pointer ring buffer
+ */
+typedef struct {
+    lfring_mpsc_slot_t *slots;  /**< Slots to operate on */
+    unsigned size;              /**< Number of slots, must be power of 2 */
+    unsigned reads;             /**< total number of reads (consumer only) */
+    atomic_uint writes;         /**< total number of reserved writes */
+} lfring_mpsc_t;
+
+/**
+ * @brief   Static initializer for @ref lfring_t
+ *
+ * @param[in] BUF   buffer array, `sizeof(BUF)` must be a power of two
+ */
+#define LFRING_INIT(BUF)        { (uint8_t *)(BUF), sizeof(BUF), 0, 0 }
+
+/**
+ * @brief   Static initializer for @ref lfring_ptr_t
+ *
+ * @param[in] BUF   array of `void *`, its length must be a power of two
+ */
+#define LFRING_PTR_INIT(BUF)    { (BUF), sizeof(BUF) / sizeof((BUF)[0]), 0, 0 }
+
+/**
+ * @brief   Initialize a byte ring buffer
+ *
+ * @param[out] rb       ring buffer to initialize
+ * @param[in]  buf      buffer to use
+ * @param[in]  size     size of @p buf, must be a power of 2
+ */
+static inline void lfring_init(lfring_t *rb, uint8_t *buf, unsigned size)
+{
+    assert((size != 0) && ((size & (size - 1)) == 0));
+    rb->buf = buf;
+    rb->size = size;
+    atomic_init(&rb->reads, 0);
+    atomic_init(&rb->writes, 0);
+}
+
+/**
+ * @brief   Get number of bytes available for reading
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  number of available bytes
+ */
+static inline unsigned lfring_avail(const lfring_t *rb)
+{
+    return atomic_load_explicit((atomic_uint *)&rb->writes, memory_order_acquire) -
+           atomic_load_explicit((atomic_uint *)&rb->reads, memory_order_acquire);
+}
+
+/**
+ * @brief   Get free space in ring buffer
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  number of bytes that can be added
+ */
+static inline unsigned lfring_free(const lfring_t *rb)
+{
+    return rb->size - lfring_avail(rb);
+}
+
+/**
+ * @brief   Test if the ring buffer is empty
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  1 if empty, 0 otherwise
+ */
+static inline int lfring_empty(const lfring_t *rb)
+{
+    return lfring_avail(rb) == 0;
+}
+
+/**
+ * @brief   Test if the ring buffer is full
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  1 if full, 0 otherwise
+ */
+static inline int lfring_full(const lfring_t *rb)
+{
+    return lfring_avail(rb) == rb->size;
+}
+
+/**
+ * @brief   Add a byte (producer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] c     byte to add
+ *
+ * @return  0 on success
+ * @return  -1 if the ring buffer is full
+ */
+int lfring_add_one(lfring_t *rb, uint8_t c);
+
+/**
+ * @brief   Add bytes (producer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] src   data to add
+ * @param[in] n     number of bytes in @p src
+ *
+ * @return  number of bytes added, less than @p n if the ring buffer is full
+ */
+size_t lfring_add(lfring_t *rb, const void *src, size_t n);
+
+/**
+ * @brief   Get a byte (consumer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  >= 0, the byte read
+ * @return  -1 if the ring buffer is empty
+ */
+int lfring_get_one(lfring_t *rb);
+
+/**
+ * @brief   Get bytes (consumer)
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] dst  buffer to copy the bytes to
+ * @param[in]  n    size of @p dst
+ *
+ * @return  number of bytes copied to @p dst
+ */
+size_t lfring_get(lfring_t *rb, void *dst, size_t n);
+
+/**
+ * @brief   Drop bytes without reading them (consumer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] n     maximum number of bytes to drop
+ *
+ * @return  number of bytes dropped
+ */
+size_t lfring_drop(lfring_t *rb, size_t n);
+
+/**
+ * @brief   Get the contiguous free space at the write position (producer)
+ *
+ * Data written to @p ptr is only visible to the consumer after
+ * lfring_write_commit().
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] ptr  start of the free space
+ *
+ * @return  number of bytes that can be written to @p ptr, 0 if full
+ */
+size_t lfring_write_peek(lfring_t *rb, uint8_t **ptr);
+
+/**
+ * @brief   Publish bytes written into the span returned by
+ *          lfring_write_peek() (producer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] n     number of bytes written, must not exceed the span size
+ */
+void lfring_write_commit(lfring_t *rb, size_t n);
+
+/**
+ * @brief   Get the contiguous readable data at the read position (consumer)
+ *
+ * The data stays in the ring buffer until lfring_read_commit().
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] ptr  start of the readable data
+ *
+ * @return  number of bytes readable at @p ptr, 0 if empty
+ */
+size_t lfring_read_peek(lfring_t *rb, const uint8_t **ptr);
+
+/**
+ * @brief   Release bytes read from the span returned by lfring_read_peek()
+ *          (consumer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] n     number of bytes consumed, must not exceed the span size
+ */
+void lfring_read_commit(lfring_t *rb, size_t n);
+
+/**
+ * @brief   Initialize a pointer ring buffer
+ *
+ * @param[out] rb       ring buffer to initialize
+ * @param[in]  buf      array of pointers to use
+ * @param[in]  size     number of pointers in @p buf, must be a power of 2
+ */
+static inline void lfring_ptr_init(lfring_ptr_t *rb, void **buf, unsigned size)
+{
+    assert((size != 0) && ((size & (size - 1)) == 0));
+    rb->buf = buf;
+    rb->size = size;
+    atomic_init(&rb->reads, 0);
+    atomic_init(&rb->writes, 0);
+}
+
+/**
+ * @brief   Get number of pointers available for reading
+ *
+ * @param[in] rb    ring buffer to operate on
+ *
+ * @return  number of available pointers
+ */
+static inline unsigned lfring_ptr_avail(const lfring_ptr_t *rb)
+{
+    return atomic_load_explicit((atomic_uint *)&rb->writes, memory_order_acquire) -
+           atomic_load_explicit((atomic_uint *)&rb->reads, memory_order_acquire);
+}
+
+/**
+ * @brief   Add a pointer (producer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] ptr   pointer to add
+ *
+ * @return  0 on success
+ * @return  -1 if the ring buffer is full
+ */
+int lfring_ptr_add_one(lfring_ptr_t *rb, void *ptr);
+
+/**
+ * @brief   Add pointers (producer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] src   pointers to add
+ * @param[in] n     number of pointers in @p src
+ *
+ * @return  number of pointers added
+ */
+size_t lfring_ptr_add(lfring_ptr_t *rb, void *const *src, size_t n);
+
+/**
+ * @brief   Get a pointer (consumer)
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] ptr  the pointer read
+ *
+ * @return  0 on success
+ * @return  -1 if the ring buffer is empty
+ */
+int lfring_ptr_get_one(lfring_ptr_t *rb, void **ptr);
+
+/**
+ * @brief   Get pointers (consumer)
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] dst  array to copy the pointers to
+ * @param[in]  n    number of pointers that fit into @p dst
+ *
+ * @return  number of pointers copied to @p dst
+ */
+size_t lfring_ptr_get(lfring_ptr_t *rb, void **dst, size_t n);
+
+/**
+ * @brief   Get the contiguous readable pointers at the read position
+ *          (consumer)
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] ptr  start of the readable pointers
+ *
+ * @return  number of pointers readable at @p ptr, 0 if empty
+ */
+size_t lfring_ptr_read_peek(lfring_ptr_t *rb, void *const **ptr);
+
+/**
+ * @brief   Release pointers read from the span returned by
+ *          lfring_ptr_read_peek() (consumer)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] n     number of pointers consumed
+ */
+void lfring_ptr_read_commit(lfring_ptr_t *rb, size_t n);
+
+/**
+ * @brief   Initialize a multi producer pointer ring buffer
+ *
+ * @param[out] rb       ring buffer to initialize
+ * @param[in]  slots    slots to use
+ * @param[in]  size     number of slots, must be a power of 2
+ */
+void lfring_mpsc_init(lfring_mpsc_t *rb, lfring_mpsc_slot_t *slots,
+                      unsigned size);
+
+/**
+ * @brief   Add a pointer (any number of producers)
+ *
+ * @param[in] rb    ring buffer to operate on
+ * @param[in] ptr   pointer to add
+ *
+ * @return  0 on success
+ * @return  -1 if the ring buffer is full
+ */
+int lfring_mpsc_add(lfring_mpsc_t *rb, void *ptr);
+
+/**
+ * @brief   Get a pointer (consumer)
+ *
+ * An element whose producer was interrupted before it finished adding it
+ * is not visible yet, as are all elements added after it.
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] ptr  the pointer read
+ *
+ * @return  0 on success
+ * @return  -1 if no element is available
+ */
+int lfring_mpsc_get_one(lfring_mpsc_t *rb, void **ptr);
+
+/**
+ * @brief   Get pointers (consumer)
+ *
+ * @param[in]  rb   ring buffer to operate on
+ * @param[out] dst  array to copy the pointers to
+ * @param[in]  n    number of pointers that fit into @p dst
+ *
+ * @return  number of pointers copied to @p dst
+ */
+size_t lfring_mpsc_get(lfring_mpsc_t *rb, void **dst, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LFRING_H */
+/** @} */
@@ -53,6 +53,9 @@
 #include "net/mqttsn.h"
 #include "net/sock/udp.h"
 #include "net/sock/util.h"
+#ifdef MODULE_SOCK_ASYNC_EVENT
+#include "net/sock/async_event.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -262,6 +265,11 @@ struct asymcute_req {
 struct asymcute_con {
     mutex_t lock;                       /**< synchronization lock */
     sock_udp_t sock;                    /**< socket used by a connections */
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+    sock_event_t sock_evt;              /**< posts events of
+                                         *   asymcute_con::sock to the handler
+                                         *   thread */
+#endif
     sock_udp_ep_t server_ep;            /**< the gateway's UDP endpoint */
     asymcute_req_t *pending;            /**< list holding pending requests */
     asymcute_sub_t *subscriptions;      /**< list holding active subscriptions */
@@ -416,6 +424,11 @@ int asymcute_topic_init(asymcute_topic_t *topic, const char *topic_name,
  * @note    Must have higher priority then the handler thread (defined by
  *          @ref ASYMCUTE_HANDLER_PRIO)
  *
+ * With the `sock_async_event` module (pulled in when GNRC is used) no thread
+ * is started. Instead, the connection's sock is served by the handler thread
+ * started with asymcute_handler_run(), which must be running already, and
+ * @p stack, @p stacksize, and @p priority are ignored.
+ *
  * @param[in] con       connection context to use for this connection
  * @param[in] stack     stack used to run the listener thread
  * @param[in] stacksize size of @p stack in bytes
@@ -425,6 +438,8 @@ int asymcute_topic_init(asymcute_topic_t *topic, const char *topic_name,
  *
  * @return  ASYMCUTE_OK on success
  * @return  ASYMCUTE_BUSY if connection context is already in use
+ * @return  ASYMCUTE_NOTSUP if the connection's sock could not be created
+ *          (only with `sock_async_event`)
  */
 int asymcute_listener_run(asymcute_con_t *con, char *stack, size_t stacksize,
                           char priority, asymcute_evt_cb_t callback);
@@ -40,6 +40,19 @@
  *   nodes.
  *
  *
+ * # Windowed Publishing
+ * By default, every function waits for the gateway's response before
+ * returning, so QoS 1 publishes take one round trip each. With the
+ * `emcute_window` module, up to @ref EMCUTE_WINDOW_SIZE QoS 1 PUBLISH
+ * messages are in flight at the same time: emcute_pub() returns as soon as
+ * the message is sent, and blocks only while the window is full. Each
+ * message in flight is kept in a slot of the window with its own retransmit
+ * timer until its PUBACK arrives. Use emcute_flush() to wait for all of them
+ * and to learn whether any failed. All other requests still wait for their
+ * response. The retransmit timers run on emCute's thread, so the module
+ * needs @ref net_sock_async_event (provided by GNRC).
+ *
+ *
  * # Error Handling
  * This implementation tries minimize parameter checks to a minimum, checking as
  * many parameters as feasible using assertions. For the sake of run-time
@@ -164,6 +177,16 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_WINDOW_SIZE
+/**
+ * @brief   Number of QoS 1 PUBLISH messages in flight at the same time with
+ *          the `emcute_window` module
+ *
+ * Each message in flight takes an @ref EMCUTE_BUFSIZE sized buffer.
+ */
+#define EMCUTE_WINDOW_SIZE      (4U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -283,6 +306,10 @@ int emcute_reg(emcute_topic_t *topic);
  * @param[in] len       length of @p data in bytes
  * @param[in] flags     flags used for publication, allowed are QoS and retain
  *
+ * With the `emcute_window` module, QoS 1 publications return EMCUTE_OK once
+ * the message is sent and never return EMCUTE_REJECT or EMCUTE_TIMEOUT; use
+ * emcute_flush() to learn about those.
+ *
  * @return  EMCUTE_OK on success
  * @return  EMCUTE_NOGW if not connected to a gateway
  * @return  EMCUTE_REJECT if publish message was rejected (QoS > 0 only)
@@ -293,6 +320,22 @@ int emcute_reg(emcute_topic_t *topic);
 int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
                unsigned flags);
 
+#if defined(MODULE_EMCUTE_WINDOW) || defined(DOXYGEN)
+/**
+ * @brief   Wait until all QoS 1 publications in flight are done
+ *
+ * @note    Only available with the `emcute_window` module
+ *
+ * @return  EMCUTE_OK if all publications since the last call were
+ *          acknowledged
+ * @return  EMCUTE_REJECT if a publication was rejected
+ * @return  EMCUTE_TIMEOUT if a publication was not acknowledged
+ * @return  EMCUTE_NOGW if the connection was closed before a publication
+ *          was acknowledged
+ */
+int emcute_flush(void);
+#endif
+
 /**
  * @brief   Subscribe to the given topic
  *
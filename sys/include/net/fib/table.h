@@ -108,7 +108,11 @@ typedef struct {
 typedef struct {
     /** A single hop OR source route data array */
     union{
-        /** array holding the FIB entries for single hops */
+        /** array holding the FIB entries for single hops.
+        *   Used entries are kept at the start of the array, network
+        *   prefixes ordered by descending length, followed by default
+        *   routes and then host routes
+        */
         fib_entry_t *entries;
         /** array holding the FIB entries for source routes */
         fib_sr_meta_t *source_routes;
@@ -119,6 +123,11 @@ typedef struct {
     uint8_t table_type;
     /** the maximim number of entries in this FIB table */
     size_t size;
+    /** earliest absolute time-point an entry of a single hop table expires,
+    *   FIB_LIFETIME_NO_EXPIRE if no entry expires. Expired entries are
+    *   removed only once it passed.
+    */
+    uint64_t next_expiry;
     /** table access mutex to grant exclusive operations on calls */
     mutex_t mtx_access;
     /** current number of registered RPs. */
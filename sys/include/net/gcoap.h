@@ -50,6 +50,12 @@
  * gcoap_register_listener() at application startup to pass in these resources,
  * wrapped in a gcoap_listener_t.
  *
+ * A request is dispatched to the first listener, in order of registration,
+ * with a resource for its path. Within a listener, the resources are bisected
+ * by path (see coap_find_resource()), so the order above is required. Add
+ * @ref COAP_MATCH_SUBTREE to the methods of a resource to have it handle all
+ * paths below its own as well, e.g. for a tree of objects.
+ *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths.
  *
@@ -131,7 +137,10 @@
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
  * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * limits registration for a given resource to a _single_ observer, unless the
+ * `gcoap_obs_multi` module is used. With that module, any number of observers
+ * (up to @ref GCOAP_OBS_REGISTRATIONS_MAX in total) may register for a
+ * resource.
  *
  * An Observe notification is considered a response to the original client
  * registration request. So, the Observe server only needs to create and send
@@ -153,6 +162,21 @@
  *
  * Finally, call gcoap_obs_send() for the resource.
  *
+ * ### Notifying all observers ###
+ *
+ * gcoap_obs_init() and gcoap_obs_send() address a single observer. To notify
+ * every observer of a resource, build the notification once and let gcoap
+ * send it to each of them:
+ *
+ * -# Call gcoap_obs_notify_init() instead of gcoap_obs_init().
+ * -# Write the payload and call gcoap_finish() as above.
+ * -# Call gcoap_obs_notify_all() for the resource.
+ *
+ * The options and payload are shared by all notifications, only the header
+ * with the message ID and the token of the observer is written for each one.
+ * The buffer must not be used otherwise until gcoap_obs_notify_all()
+ * returns.
+ *
  * ### Other considerations ###
  *
  * By default, the value for the Observe option in a notification is three
@@ -184,11 +208,24 @@
  *
  * ### Waiting for a response ###
  *
- * We take advantage of RIOT's asynchronous messaging by using an xtimer to wait
- * for a response, so the gcoap thread does not block while waiting. The user is
- * notified via the same callback, whether the message is received or the wait
- * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * gcoap's thread handles an @ref sys_event "event queue". Its sock posts an
+ * event to the queue when a message is received (see
+ * @ref net_sock_async_event), and an @ref event_timeout_t posts an event when
+ * the wait for a response times out, so the gcoap thread never blocks on the
+ * sock while waiting. The user is notified via the same callback, whether the
+ * message is received or the wait times out. We track the response with an
+ * entry in the `_coap_state.open_reqs` array.
+ *
+ * ### Scaling to many requests and observers ###
+ *
+ * Open requests are found by their token, Observe clients by their endpoint
+ * and Observe registrations by their token or resource in small hash tables,
+ * and free entries as well as resend buffers for confirmable requests are
+ * taken from pools. So the cost of handling a message does not grow with
+ * the number of entries, and a gateway may raise @ref GCOAP_REQ_WAITING_MAX,
+ * @ref GCOAP_RESEND_BUFS_MAX, @ref GCOAP_OBS_CLIENTS_MAX and
+ * @ref GCOAP_OBS_REGISTRATIONS_MAX to hundreds. Raise
+ * @ref GCOAP_REQ_HASH_BUCKETS and @ref GCOAP_OBS_HASH_BUCKETS along with them.
  *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
@@ -225,6 +262,8 @@
 #include "net/ipv6/addr.h"
 #include "net/sock/udp.h"
 #include "net/nanocoap.h"
+#include "event/callback.h"
+#include "event/timeout.h"
 #include "xtimer.h"
 
 #ifdef __cplusplus
@@ -233,6 +272,9 @@ extern "C" {
 
 /**
  * @brief  Size for module message queue
+ *
+ * @deprecated  gcoap handles an event queue and no longer uses a message
+ *              queue; will be removed after the next release
  */
 #ifndef GCOAP_MSG_QUEUE_SIZE
 #define GCOAP_MSG_QUEUE_SIZE    (4)
@@ -281,6 +323,14 @@ extern "C" {
 #define GCOAP_REQ_WAITING_MAX   (2)
 #endif
 
+/**
+ * @brief   Number of hash buckets to look up requests awaiting a response by
+ *          token; must be a power of two
+ */
+#ifndef GCOAP_REQ_HASH_BUCKETS
+#define GCOAP_REQ_HASH_BUCKETS  (4U)
+#endif
+
 /**
  * @brief   Maximum length in bytes for a token
  */
@@ -319,13 +369,6 @@ extern "C" {
  */
 #define GCOAP_SEND_LIMIT_NON    (-1)
 
-/**
- * @brief   Time in usec that the event loop waits for an incoming CoAP message
- */
-#ifndef GCOAP_RECV_TIMEOUT
-#define GCOAP_RECV_TIMEOUT      (1 * US_PER_SEC)
-#endif
-
 /**
  * @brief   Default time to wait for a non-confirmable response [in usec]
  *
@@ -335,8 +378,21 @@ extern "C" {
 #define GCOAP_NON_TIMEOUT       (5000000U)
 #endif
 
+/**
+ * @brief   Time in usec that the event loop waits for an incoming CoAP message
+ *
+ * @deprecated  gcoap's event loop no longer polls its sock; will be removed
+ *              after the next release
+ */
+#ifndef GCOAP_RECV_TIMEOUT
+#define GCOAP_RECV_TIMEOUT      (1 * US_PER_SEC)
+#endif
+
 /**
  * @brief   Identifies waiting timed out for a response to a sent message
+ *
+ * @deprecated  Response timeouts are events, not messages; will be removed
+ *              after the next release
  */
 #define GCOAP_MSG_TYPE_TIMEOUT  (0x1501)
 
@@ -344,7 +400,8 @@ extern "C" {
  * @brief   Identifies a request to interrupt listening for an incoming message
  *          on a sock
  *
- * Allows the event loop to process IPC messages.
+ * @deprecated  The event loop needs no interruption; will be removed after
+ *              the next release
  */
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
@@ -363,6 +420,14 @@ extern "C" {
 #define GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @brief   Number of hash buckets to look up Observe clients by endpoint and
+ *          registrations by token or resource; must be a power of two
+ */
+#ifndef GCOAP_OBS_HASH_BUCKETS
+#define GCOAP_OBS_HASH_BUCKETS  (4U)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -472,8 +537,8 @@ typedef struct {
                                              supports resending message */
     sock_udp_ep_t remote_ep;            /**< Remote endpoint */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
-    xtimer_t response_timer;            /**< Limits wait for response */
-    msg_t timeout_msg;                  /**< For response timer */
+    event_callback_t resp_evt;          /**< Handles the response timeout */
+    event_timeout_t resp_tmout;         /**< Limits wait for response */
 } gcoap_request_memo_t;
 
 /**
@@ -646,7 +711,8 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @brief   Sends a buffer containing a CoAP Observe notification to the
  *          observer registered for a resource
  *
- * Assumes a single observer for a resource.
+ * Assumes a single observer for a resource, see gcoap_obs_notify_all()
+ * otherwise.
  *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
@@ -658,6 +724,41 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource);
 
+/**
+ * @brief   Initializes a CoAP Observe notification packet on a buffer, for
+ *          all observers registered for a resource
+ *
+ * Leaves room in front of the options for the header of any observer, see
+ * gcoap_obs_notify_all().
+ *
+ * @param[out] pdu      Notification metadata
+ * @param[out] buf      Buffer containing the PDU
+ * @param[in] len       Length of the buffer
+ * @param[in] resource  Resource for the notification
+ *
+ * @return  GCOAP_OBS_INIT_OK     on success
+ * @return  GCOAP_OBS_INIT_ERR    if the buffer is too small
+ * @return  GCOAP_OBS_INIT_UNUSED if no observer for resource
+ */
+int gcoap_obs_notify_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          const coap_resource_t *resource);
+
+/**
+ * @brief   Sends a CoAP Observe notification to all observers registered for
+ *          a resource
+ *
+ * Writes the header for each observer into @p buf before sending it, so the
+ * notification must have been initialized with gcoap_obs_notify_init().
+ *
+ * @param[in,out] buf   Buffer containing the PDU
+ * @param[in] len       Length of the PDU, as returned by gcoap_finish()
+ * @param[in] resource  Resource to send
+ *
+ * @return  count of observers the notification was sent to
+ */
+size_t gcoap_obs_notify_all(uint8_t *buf, size_t len,
+                            const coap_resource_t *resource);
+
 /**
  * @brief   Provides important operational statistics
  *
@@ -665,7 +766,7 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
  *
  * @return  count of unanswered requests
  */
-uint8_t gcoap_op_state(void);
+unsigned gcoap_op_state(void);
 
 /**
  * @brief   Get the resource list, currently only `CoRE Link Format`
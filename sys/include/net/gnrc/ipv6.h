@@ -67,6 +67,16 @@ extern "C" {
 #define GNRC_IPV6_MSG_QUEUE_SIZE    (8U)
 #endif
 
+/**
+ * @brief   Maximum number of messages the IPv6 thread takes from its message
+ *          queue per wakeup
+ *
+ * @see     msg_receive_bulk()
+ */
+#ifndef GNRC_IPV6_MSG_BULK_SIZE
+#define GNRC_IPV6_MSG_BULK_SIZE     (4U)
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief   Add a static IPv6 link local address to any network interface
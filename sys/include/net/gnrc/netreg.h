@@ -35,6 +35,20 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t in the registry
+ *
+ * @note    Only used with the `gnrc_netreg_hash` module. Must be a power of
+ *          two.
+ *
+ * With `gnrc_netreg_hash` the entries of every protocol type are distributed
+ * over this many lists by their gnrc_netreg_entry_t::demux_ctx, so looking up
+ * e.g. a UDP port does not need to walk over the entries of all other ports.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (8U)
+#endif
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -348,6 +362,28 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  */
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Searches for entries with given parameters in the registry and
+ *          returns the first found together with the number of entries
+ *          fitting the given parameters.
+ *
+ * This is the same as calling gnrc_netreg_num() and gnrc_netreg_lookup() but
+ * only searches the registry once.
+ *
+ * @param[in] type      Type of the protocol.
+ * @param[in] demux_ctx The demultiplexing context for the registered thread.
+ *                      See gnrc_netreg_entry_t::demux_ctx.
+ * @param[out] num      Number of entries with the same
+ *                      gnrc_netreg_entry_t::type and
+ *                      gnrc_netreg_entry_t::demux_ctx as the given
+ *                      parameters. Must not be NULL.
+ *
+ * @return  The first entry fitting the given parameters on success
+ * @return  NULL if no entry can be found.
+ */
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num);
+
 /**
  * @brief   Returns the next entry after @p entry with the same
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
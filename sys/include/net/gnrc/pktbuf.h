@@ -58,6 +58,45 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size classes of the slab packet buffer
+ * @brief   Block sizes and numbers of blocks used by `gnrc_pktbuf_slab`
+ *
+ * @details `gnrc_pktbuf_slab` replaces the first-fit allocator of
+ *          `gnrc_pktbuf_static` with one free list per size class, so
+ *          allocation and release run in constant time and the buffer can not
+ *          fragment externally. Packet snips have a class of their own, data is
+ *          served from the smallest class that fits and still has a free block.
+ *          The default classes cover headers, a full IEEE 802.15.4 frame and a
+ *          full Ethernet frame. Block sizes must be multiples of
+ *          `sizeof(void *)`.
+ *
+ *          @ref GNRC_PKTBUF_SIZE does not apply to this backend.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (32U)   /**< number of packet snips */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64U)   /**< size of header blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (16U)   /**< number of header blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_FRAME_SIZE
+#define GNRC_PKTBUF_SLAB_FRAME_SIZE     (128U)  /**< size of 802.15.4 frame blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_FRAME_NUMOF
+#define GNRC_PKTBUF_SLAB_FRAME_NUMOF    (16U)   /**< number of 802.15.4 frame blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MTU_SIZE
+#define GNRC_PKTBUF_SLAB_MTU_SIZE       (1536U) /**< size of Ethernet frame blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MTU_NUMOF
+#define GNRC_PKTBUF_SLAB_MTU_NUMOF      (2U)    /**< number of Ethernet frame blocks */
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -281,7 +320,9 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. With
+ *          `gnrc_pktbuf_slab` they include the usage, high-water mark,
+ *          allocation failures and internal fragmentation of each size class.
  */
 void gnrc_pktbuf_stats(void);
 #endif
@@ -14,6 +14,19 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * With the `gnrc_sixlowpan_frag_vrb` module, a router does not reassemble
+ * datagrams it only forwards. Instead it keeps a *virtual reassembly buffer*
+ * (VRB) entry per datagram: The first fragment is decompressed just far
+ * enough to look up the next hop, then recompressed and forwarded under a new
+ * datagram tag. All subsequent fragments are relabeled with that tag and
+ * forwarded right away as they arrive. Datagrams the VRB can not handle
+ * (e.g. those addressed to the router itself or those for which the next hop
+ * needs address resolution first) are reassembled as before.
+ *
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-00">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly-00
+ *      </a>
  * @{
  *
  * @file
@@ -54,6 +67,14 @@ extern "C" {
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
 /** @} */
 
+/**
+ * @brief   Number of datagrams that can be forwarded concurrently by the
+ *          virtual reassembly buffer
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (4U)
+#endif
+
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
  *
@@ -103,6 +124,13 @@ typedef struct {
  */
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 
+/**
+ * @brief   Generates a new datagram tag for sending
+ *
+ * @return  A new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Sends a packet fragmented
  *
@@ -158,6 +186,23 @@ void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf);
  */
 void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf,
                                                      gnrc_netif_hdr_t *netif);
+
+/**
+ * @brief   Statistics of the reassembly buffer
+ */
+typedef struct {
+    uint32_t evicted;       /**< datagrams dropped to make room for new ones */
+    uint32_t timed_out;     /**< datagrams dropped due to a timeout */
+    uint32_t discarded;     /**< datagrams dropped due to invalid fragments */
+    uint32_t duplicates;    /**< duplicate fragments ignored */
+} gnrc_sixlowpan_frag_rbuf_stats_t;
+
+/**
+ * @brief   Gets the statistics of the reassembly buffer
+ *
+ * @return  The statistics of the reassembly buffer.
+ */
+const gnrc_sixlowpan_frag_rbuf_stats_t *gnrc_sixlowpan_frag_rbuf_stats(void);
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag is not
  * compiled in */
@@ -166,6 +211,23 @@ void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf
     (void)(rbuf); (void)(netif)
 #endif
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Statistics of the virtual reassembly buffer
+ */
+typedef struct {
+    uint32_t datagrams; /**< datagrams forwarded without reassembly */
+    uint32_t fragments; /**< fragments sent for those datagrams */
+} gnrc_sixlowpan_frag_vrb_stats_t;
+
+/**
+ * @brief   Gets the statistics of the virtual reassembly buffer
+ *
+ * @return  The statistics of the virtual reassembly buffer.
+ */
+const gnrc_sixlowpan_frag_vrb_stats_t *gnrc_sixlowpan_frag_vrb_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
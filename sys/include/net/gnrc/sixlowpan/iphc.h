@@ -21,6 +21,7 @@
 #define NET_GNRC_SIXLOWPAN_IPHC_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
@@ -29,6 +30,21 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of flows the address compression decisions are cached for
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`
+ *
+ * Which contexts and address modes are used to compress the addresses of a
+ * packet only depends on the addresses and the link-layer addresses of the
+ * packet. With module `gnrc_sixlowpan_iphc_cache` this decision is cached
+ * for the last flows sent, so context look-ups and the link-layer based
+ * interface identifier do not have to be determined again for every packet.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (4U)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -44,6 +60,22 @@ extern "C" {
  */
 void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+/**
+ * @brief   Compresses the IPv6 header (and the UDP header with module
+ *          `gnrc_sixlowpan_iphc_nhc`) of a packet in place.
+ *
+ * @pre (pkt != NULL)
+ *
+ * @param[in,out] pkt   A packet in sending order, starting with a
+ *                      @ref gnrc_netif_hdr_t, followed by the uncompressed
+ *                      IPv6 header. On success the IPv6 header is replaced
+ *                      by the IPHC dispatch. Released on error.
+ *
+ * @return  true, on success.
+ * @return  false, on error.
+ */
+bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Compresses a 6LoWPAN for IPHC.
  *
@@ -57,6 +89,31 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Statistics of the compression cache
+ */
+typedef struct {
+    uint32_t hits;      /**< packets compressed with cached decisions */
+    uint32_t misses;    /**< packets compressed without cached decisions */
+} gnrc_sixlowpan_iphc_cache_stats_t;
+
+/**
+ * @brief   Invalidates all entries of the compression cache
+ *
+ * Called when contexts or link-layer addresses change. May be called from
+ * any thread.
+ */
+void gnrc_sixlowpan_iphc_cache_flush(void);
+
+/**
+ * @brief   Gets the statistics of the compression cache
+ *
+ * @return  The statistics of the compression cache.
+ */
+const gnrc_sixlowpan_iphc_cache_stats_t *gnrc_sixlowpan_iphc_cache_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -122,6 +122,11 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data was handed to the network stack and is retransmitted
+ *       until the peer acknowledges it, so the call does not wait for the
+ *       acknowledgment. The amount of data in flight is limited by the peers
+ *       receive window, the congestion window and
+ *       @ref GNRC_TCP_RETRANSMIT_QUEUE_SIZE.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -134,7 +139,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  *            -ENOTCONN if connection is not established.
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
- *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired or the connection
+ *            was closed because the peer did not acknowledge the data sent after
+ *            @ref GNRC_TCP_RETRANSMIT_MAX retransmissions.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
@@ -164,7 +171,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
  *            -EAGAIN if  user_timeout_duration_us is zero and no data is available.
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
- *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired or the connection
+ *            was closed because the peer did not acknowledge the data sent after
+ *            @ref GNRC_TCP_RETRANSMIT_MAX retransmissions.
  */
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t user_timeout_duration_us);
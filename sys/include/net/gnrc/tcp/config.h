@@ -95,6 +95,13 @@ extern "C" {
 #define GNRC_TCP_RTO_UPPER_BOUND (60U * US_PER_SEC)
 #endif
 
+/**
+ * @brief Number of retransmission timeouts after which a connection is aborted
+ */
+#ifndef GNRC_TCP_RETRANSMIT_MAX
+#define GNRC_TCP_RETRANSMIT_MAX (8U)
+#endif
+
 /**
  * @brief Assumes clock granularity for TCP of 10 ms (see RFC 6298)
  */
@@ -137,6 +144,36 @@ extern "C" {
 #define GNRC_TCP_PROBE_UPPER_BOUND (60U * US_PER_SEC)
 #endif
 
+/**
+ * @brief Number of segments the retransmission queue of a TCB can hold.
+ *
+ * This is the maximum number of segments in flight. One slot is kept for the
+ * FIN, so up to (GNRC_TCP_RETRANSMIT_QUEUE_SIZE - 1) data segments are sent
+ * without waiting for an acknowledgment.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Number of out-of-order segments a TCB keeps until the gap in front
+ *        of them is filled.
+ *
+ * Each entry holds a received packet in the packet buffer. Segments are only
+ * accepted within the receive window, so the queue fills up only if the window
+ * spans several segments (see @ref GNRC_TCP_MSS_MULTIPLICATOR).
+ */
+#ifndef GNRC_TCP_OOO_QUEUE_SIZE
+#define GNRC_TCP_OOO_QUEUE_SIZE (4U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
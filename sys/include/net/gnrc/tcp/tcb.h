@@ -73,10 +73,21 @@ typedef struct _transmission_control_block {
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
-    uint8_t retries;       /**< Number of retransmissions */
+    uint8_t retries;       /**< Number of retransmission timeouts */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    uint32_t rtt_seq;      /**< Sequence number that ends the rtt measurement */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent on loss detection (RFC 6582) */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
+    uint8_t rtx_head;      /**< Index of the oldest segment in the retransmit queue */
+    uint8_t rtx_numof;     /**< Number of segments in the retransmit queue */
+    gnrc_pktsnip_t *rtx_queue[GNRC_TCP_RETRANSMIT_QUEUE_SIZE]; /**< Sent, unacknowledged segments */
+    uint8_t rtx_flags[GNRC_TCP_RETRANSMIT_QUEUE_SIZE];         /**< SACK state of rtx_queue */
+    uint8_t ooo_numof;     /**< Number of segments in the out-of-order queue */
+    uint32_t ooo_recent;   /**< Sequence number of the latest out-of-order segment */
+    gnrc_pktsnip_t *ooo_queue[GNRC_TCP_OOO_QUEUE_SIZE]; /**< Received segments after a gap */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
@@ -111,6 +111,8 @@ extern "C" {
 #define COAP_POST               (0x2)
 #define COAP_PUT                (0x4)
 #define COAP_DELETE             (0x8)
+#define COAP_MATCH_SUBTREE      (0x8000) /**< resource also handles all paths
+                                              below its own */
 /** @} */
 
 /**
@@ -375,6 +377,30 @@ ssize_t coap_reply_simple(coap_pkt_t *pkt,
                           unsigned ct,
                           const uint8_t *payload, uint8_t payload_len);
 
+/**
+ * @brief   Finds the resource for a URI path
+ *
+ * @p resources must be ordered alphabetically by path (as by `strcmp()`), so
+ * they can be bisected. A resource with exactly the path @p uri is preferred.
+ * Otherwise the @ref COAP_MATCH_SUBTREE resource with the longest path that
+ * @p uri is below (e.g. `/a` for `/a/b/c`, but not for `/ab`) is chosen.
+ *
+ * @param[in]   resources       resources to search, ordered by path
+ * @param[in]   resources_numof number of entries in @p resources
+ * @param[in]   uri             URI path of the request
+ * @param[in]   method_flag     method flag of the request, see
+ *                              coap_method2flag()
+ * @param[out]  resource        the resource found
+ *
+ * @returns     0 on success
+ * @returns     -ENOENT if no resource matches @p uri
+ * @returns     -ENOTSUP if resources match @p uri, but none of them allows
+ *              @p method_flag
+ */
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const char *uri, unsigned method_flag,
+                       const coap_resource_t **resource);
+
 /**
  * @brief   Handle incoming CoAP request
  *
@@ -36,7 +36,8 @@ extern "C" {
  * receiving of UDP packets fails.
  *
  * @param[in]   local   local UDP endpoint to bind to
- * @param[in]   buf     input buffer to use
+ * @param[in]   buf     buffer to build responses in; requests are parsed
+ *                      in the receive buffer of the network stack
  * @param[in]   bufsize size of @p buf
  *
  * @returns     -1 on error
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock events
+ * @ingroup     net_sock
+ * @brief       Callbacks on sock events
+ *
+ * With the `sock_async` module a callback can be attached to a sock that is
+ * called whenever an event occurs on it, e.g. a message was received. This
+ * allows a single thread to wait for events of many socks instead of blocking
+ * in the receive function of one of them.
+ *
+ * The callback is called in the context of the network stack, or for
+ * @ref SOCK_ASYNC_MSG_SENT in the context of the sending thread. It should
+ * only notify the thread handling the sock, e.g. by setting a thread flag or
+ * by posting an event (see @ref net_sock_async_event), and must not call any
+ * sock functions itself.
+ *
+ * @note    Currently only implemented by @ref net_gnrc_sock.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Asynchronous sock definitions
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#include "net/sock/async/types.h"
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+#include "net/sock/ip.h"
+#endif
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+#include "net/sock/udp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Sets the event callback of a raw IPv4/IPv6 sock
+ *
+ * @pre `sock != NULL` and @p sock was created with sock_ip_create()
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] cb        An event callback. May be `NULL` to remove the
+ *                      callback.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg);
+#endif
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Sets the event callback of a UDP sock
+ *
+ * @pre `sock != NULL` and @p sock was created with sock_udp_create()
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] cb        An event callback. May be `NULL` to remove the
+ *                      callback.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
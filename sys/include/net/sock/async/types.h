@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_sock_async
+ * @{
+ *
+ * @file
+ * @brief   Type definitions for asynchronous sock
+ *
+ * Kept separate from @ref net/sock/async.h so stack-specific sock types can
+ * embed the callbacks.
+ */
+#ifndef NET_SOCK_ASYNC_TYPES_H
+#define NET_SOCK_ASYNC_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Flags for asynchronous sock events
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x0001,   /**< a message is ready to be received */
+    SOCK_ASYNC_MSG_SENT = 0x0002,   /**< a message was handed to the stack,
+                                     *   the sock is ready to send again */
+} sock_async_flags_t;
+
+struct sock_ip;
+struct sock_udp;
+
+/**
+ * @brief   Event callback for @ref sock_ip_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags
+ * @param[in] arg   Argument given to sock_ip_set_cb()
+ */
+typedef void (*sock_ip_cb_t)(struct sock_ip *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_udp_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags
+ * @param[in] arg   Argument given to sock_udp_set_cb()
+ */
+typedef void (*sock_udp_cb_t)(struct sock_udp *sock, sock_async_flags_t flags,
+                              void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_TYPES_H */
+/** @} */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async_event    Asynchronous sock with event queues
+ * @ingroup     net_sock_async
+ * @brief       Posts sock events to an @ref sys_event "event queue"
+ *
+ * With the `sock_async_event` module a sock can be attached to an event
+ * queue. Whenever a message was received on the sock or a message was sent
+ * from it, an event is posted to the queue and the handler given to
+ * sock_udp_event_init() or sock_ip_event_init() is called in the context of
+ * the thread handling the queue. In the handler the sock functions can be
+ * called like in any other thread, e.g. the received messages can be fetched
+ * with a timeout of 0:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+ * {
+ *     if (flags & SOCK_ASYNC_MSG_RECV) {
+ *         sock_udp_ep_t remote;
+ *         ssize_t res;
+ *
+ *         while ((res = sock_udp_recv(sock, buf, sizeof(buf), 0,
+ *                                     &remote)) >= 0) {
+ *             ...
+ *         }
+ *     }
+ * }
+ *
+ * int main(void)
+ * {
+ *     event_queue_init(&queue);
+ *     sock_udp_create(&sock, &local, NULL, 0);
+ *     sock_udp_event_init(&sock, &sock_event, &queue, _handler, NULL);
+ *     event_loop(&queue);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Several socks (and other events, e.g. @ref event_timeout_t) can share one
+ * queue, so a single thread can serve all of them without arming a timer for
+ * every receive call.
+ *
+ * Events that occur while the sock's event is still queued are merged into
+ * the flags of that event.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Asynchronous sock using event queues definitions
+ */
+#ifndef NET_SOCK_ASYNC_EVENT_H
+#define NET_SOCK_ASYNC_EVENT_H
+
+#include "event.h"
+#include "net/sock/async.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event of a sock
+ *
+ * @note    All members are managed by the sock_async_event module and should
+ *          not be accessed by the user.
+ */
+typedef struct {
+    event_t super;                  /**< event structure that gets posted */
+    event_queue_t *queue;           /**< queue the event is posted to */
+    void *sock;                     /**< sock the event happened on */
+    /**
+     * @brief   handler for the event
+     */
+    union {
+        void (*generic)(void *, sock_async_flags_t, void *);
+                                    /**< generic version */
+        sock_ip_cb_t ip;            /**< raw IP version */
+        sock_udp_cb_t udp;          /**< UDP version */
+    } handler;
+    void *handler_arg;              /**< argument for sock_event_t::handler */
+    sock_async_flags_t flags;       /**< events that occurred since the last
+                                     *   call of sock_event_t::handler */
+} sock_event_t;
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Posts the events of a raw IPv4/IPv6 sock to an event queue
+ *
+ * @pre `(sock != NULL) && (event != NULL) && (queue != NULL)`
+ * @pre @p sock was created with sock_ip_create()
+ *
+ * @param[in] sock          A raw IPv4/IPv6 sock object.
+ * @param[out] event        The event object for @p sock. Must stay valid as
+ *                          long as @p sock is attached to @p queue.
+ * @param[in] queue         The event queue. Must be initialized.
+ * @param[in] handler       Called in the thread handling @p queue when an
+ *                          event occurred on @p sock.
+ * @param[in] handler_arg   Argument for @p handler.
+ */
+void sock_ip_event_init(sock_ip_t *sock, sock_event_t *event,
+                        event_queue_t *queue, sock_ip_cb_t handler,
+                        void *handler_arg);
+#endif
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Posts the events of a UDP sock to an event queue
+ *
+ * @pre `(sock != NULL) && (event != NULL) && (queue != NULL)`
+ * @pre @p sock was created with sock_udp_create()
+ *
+ * @param[in] sock          A UDP sock object.
+ * @param[out] event        The event object for @p sock. Must stay valid as
+ *                          long as @p sock is attached to @p queue.
+ * @param[in] queue         The event queue. Must be initialized.
+ * @param[in] handler       Called in the thread handling @p queue when an
+ *                          event occurred on @p sock.
+ * @param[in] handler_arg   Argument for @p handler.
+ */
+void sock_udp_event_init(sock_udp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_udp_cb_t handler,
+                         void *handler_arg);
+#endif
+
+/**
+ * @brief   Removes pending events of a closed sock from its event queue
+ *
+ * Must be called from the thread handling the queue after the sock was
+ * closed with sock_udp_close() or sock_ip_close(). Afterwards @p event can be
+ * reused.
+ *
+ * @param[in] event The event object given to sock_udp_event_init() or
+ *                  sock_ip_event_init().
+ */
+void sock_event_clear(sock_event_t *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_EVENT_H */
+/** @} */
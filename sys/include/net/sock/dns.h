@@ -12,6 +12,26 @@
  *
  * @brief       Sock DNS client
  *
+ * Queries from different threads for the same name and address family are
+ * sent only once: threads asking while a query is in flight wait for its
+ * result instead of sending their own.
+ *
+ * # Caching
+ *
+ * With the `sock_dns_cache` module, answers are kept for their TTL (limited
+ * to @ref SOCK_DNS_CACHE_TTL_MAX) in a table of @ref SOCK_DNS_CACHE_SIZE
+ * entries, so repeated lookups do not hit the network. Negative answers
+ * (NXDOMAIN or no record of the requested type) are cached as well if the
+ * server supplies an SOA record to derive their TTL from (see
+ * [RFC 2308](https://tools.ietf.org/html/rfc2308)). When the table is full,
+ * the entry that expires first is replaced.
+ *
+ * # Asynchronous queries
+ *
+ * With the `sock_dns_async` module, @ref sock_dns_query_async() hands a
+ * query to a resolver thread and returns right away; the result is passed
+ * to a callback in the context of that thread.
+ *
  * @{
  *
  * @file
@@ -28,6 +48,10 @@
 #include <unistd.h>
 
 #include "net/sock/udp.h"
+#ifdef MODULE_SOCK_DNS_ASYNC
+#include "event.h"
+#include "thread.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,11 +80,40 @@ typedef struct {
 
 #define SOCK_DNS_PORT           (53)
 #define SOCK_DNS_RETRIES        (2)
+#define SOCK_DNS_TIMEOUT        (1000000LU) /* per try, in microseconds */
 
 #define SOCK_DNS_MAX_NAME_LEN   (64U)       /* we're in embedded context. */
 #define SOCK_DNS_QUERYBUF_LEN   (sizeof(sock_dns_hdr_t) + 4 + SOCK_DNS_MAX_NAME_LEN)
 /** @} */
 
+/**
+ * @brief   Number of answers kept by the `sock_dns_cache` module
+ */
+#ifndef SOCK_DNS_CACHE_SIZE
+#define SOCK_DNS_CACHE_SIZE     (4U)
+#endif
+
+/**
+ * @brief   Maximum time in seconds an answer is cached, regardless of its TTL
+ */
+#ifndef SOCK_DNS_CACHE_TTL_MAX
+#define SOCK_DNS_CACHE_TTL_MAX  (86400U)
+#endif
+
+/**
+ * @brief   Stack size of the resolver thread of the `sock_dns_async` module
+ */
+#ifndef SOCK_DNS_ASYNC_STACKSIZE
+#define SOCK_DNS_ASYNC_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the resolver thread of the `sock_dns_async` module
+ */
+#ifndef SOCK_DNS_ASYNC_PRIO
+#define SOCK_DNS_ASYNC_PRIO     (THREAD_PRIORITY_MAIN - 1)
+#endif
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -80,11 +133,71 @@ typedef struct {
  * @param[out]  addr_out        buffer to write result into
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
- * @return      0 on success
- * @return      !=0 otherwise
+ * @return      length of the address written to @p addr_out on success
+ * @return      -ECONNREFUSED, if @ref sock_dns_server is not set
+ * @return      -ENOSPC, if @p domain_name is too long
+ * @return      <0, if the name could not be resolved
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+#if defined(MODULE_SOCK_DNS_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Drops all cached answers
+ */
+void sock_dns_cache_flush(void);
+#endif
+
+#if defined(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Forward declaration of an asynchronous query
+ */
+typedef struct sock_dns_async sock_dns_async_t;
+
+/**
+ * @brief   Callback for the result of an asynchronous query
+ *
+ * @param[in] req   The query. Its `addr` holds the address on success.
+ * @param[in] res   The return value of @ref sock_dns_query() for the query.
+ */
+typedef void (*sock_dns_cb_t)(sock_dns_async_t *req, int res);
+
+/**
+ * @brief   An asynchronous query
+ *
+ * The members are set by @ref sock_dns_query_async(). The query must stay
+ * valid until its callback was called.
+ */
+struct sock_dns_async {
+    event_t super;              /**< event posted to the resolver thread */
+    const char *domain_name;    /**< name to resolve */
+    int family;                 /**< requested address family */
+    sock_dns_cb_t cb;           /**< called with the result */
+    uint8_t addr[16];           /**< the resolved address */
+};
+
+/**
+ * @brief   Resolves a DNS name without blocking
+ *
+ * The query is handled by a resolver thread, which is started on the first
+ * call. If the answer is cached, @p cb is called before this function
+ * returns.
+ *
+ * @param[out]  req             The query. Must not be NULL.
+ * @param[in]   domain_name     DNS name to resolve into address. Must stay
+ *                              valid until @p cb was called.
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ * @param[in]   cb              Called with the result of the query. Must not
+ *                              be NULL.
+ *
+ * @return      0, if the query was started
+ * @return      -ECONNREFUSED, if @ref sock_dns_server is not set
+ * @return      -ENOSPC, if @p domain_name is too long
+ * @return      -ENOMEM, if the resolver thread could not be started
+ */
+int sock_dns_query_async(sock_dns_async_t *req, const char *domain_name,
+                         int family, sock_dns_cb_t cb);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
@@ -402,6 +402,66 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Provides stack-internal buffer space containing a UDP message from
+ *          a remote end point
+ *
+ * In contrast to @ref sock_udp_recv() the received data is not copied into a
+ * buffer of the caller, but handed out as a read-only view into the buffer
+ * of the network stack.
+ *
+ * The received message may be split into several chunks by the stack. Calling
+ * this function again with the @p buf_ctx of a previous call hands out the
+ * next chunk. If there are no more chunks, the buffer is released, 0 is
+ * returned and both `*data` and `*buf_ctx` are set to `NULL`. The buffer
+ * must always be released this way, even if the caller is not interested in
+ * the remaining chunks:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res;
+ *
+ * while ((res = sock_udp_recv_buf(&sock, &data, &ctx, SOCK_NO_TIMEOUT,
+ *                                 NULL)) > 0) {
+ *     process(data, res);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the stack-internal buffer space containing
+ *                      the received data. The data must not be written to.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. If it points to a
+ *                      `NULL` pointer, a new message is received. Otherwise
+ *                      the next chunk of the message of a previous call is
+ *                      provided or the message is released.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available). Ignored if `*buf_ctx != NULL`.
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *                      Only set if `*buf_ctx == NULL`.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes provided in @p data on success.
+ * @return  0, if no received data is available or the buffer referred to by
+ *          @p buf_ctx was released. @p buf_ctx points to `NULL` in that case.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -84,6 +84,19 @@ void universal_address_reset(void);
  */
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size);
 
+/**
+ * @brief Look up the container of a given address without changing its
+ *        universal_address_container_t::use_count
+ *
+ * @param[in] addr       pointer to the address
+ * @param[in] addr_size  the number of bytes of the address
+ *
+ * @return pointer to the universal_address_container_t containing the address
+ *         if it is in use
+ * @return NULL if the address is not in use
+ */
+universal_address_container_t *universal_address_find(uint8_t *addr, size_t addr_size);
+
 /**
  * @brief Add a given container from the universal address entries. If the entry exists,
  *        the universal_address_container_t::use_count will be decreased.
@@ -158,6 +158,25 @@ extern "C" {
  */
 #define VFS_ANY_FD (-1)
 
+/**
+ * @name    Events for vfs_poll()
+ *
+ * The values match the corresponding `POLL*` constants of POSIX `poll.h`.
+ * @{
+ */
+#define VFS_POLLIN      (0x0001)    /**< data may be read without blocking */
+#define VFS_POLLOUT     (0x0004)    /**< data may be written without blocking */
+#define VFS_POLLERR     (0x0008)    /**< an error occurred on the file */
+/** @} */
+
+#ifndef VFS_POLL_THREAD_FLAG
+/**
+ * @brief   Thread flag set on the waiter of vfs_poll() when the readiness of
+ *          a file may have changed
+ */
+#define VFS_POLL_THREAD_FLAG    (1u << 13)
+#endif
+
 /* Forward declarations */
 /**
  * @brief struct @c vfs_file_ops typedef
@@ -370,6 +389,26 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Query the readiness of an open file
+     *
+     * If none of @p events is ready and @p waiter is not
+     * @ref KERNEL_PID_UNDEF, the driver sets @ref VFS_POLL_THREAD_FLAG on
+     * @p waiter as soon as the readiness of the file may have changed. Only
+     * the waiter of the most recent call is stored, @ref KERNEL_PID_UNDEF
+     * removes it.
+     *
+     * A file that does not implement this operation is always ready.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  events   events to query (`VFS_POLL*`)
+     * @param[in]  waiter   thread to notify, or @ref KERNEL_PID_UNDEF
+     *
+     * @return subset of @p events that is ready, or @ref VFS_POLLERR
+     * @return <0 on error
+     */
+    int (*poll) (vfs_file_t *filp, unsigned events, kernel_pid_t waiter);
 };
 
 /**
@@ -669,6 +708,22 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Query the readiness of an open file
+ *
+ * See vfs_file_ops::poll for the semantics of @p waiter.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  events   events to query (`VFS_POLL*`)
+ * @param[in]  waiter   thread to notify with @ref VFS_POLL_THREAD_FLAG when
+ *                      the readiness may have changed, or
+ *                      @ref KERNEL_PID_UNDEF
+ *
+ * @return subset of @p events that is ready, or @ref VFS_POLLERR
+ * @return <0 on error
+ */
+int vfs_poll(int fd, unsigned events, kernel_pid_t waiter);
+
 /**
  * @brief Open a directory for reading with readdir
  *
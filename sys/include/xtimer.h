@@ -20,6 +20,18 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * Alternatively, the `xtimer_wheel` pseudo module replaces these lists by a
+ * hierarchical timing wheel (see @ref XTIMER_WHEEL_SHIFT). Setting a timer
+ * is then O(1) (plus a sorted insert for timers expiring within the current
+ * wheel bucket) and removing a timer only walks the bucket the timer is
+ * stored in. The API is the same for both backends.
+ *
+ * With the `xtimer_coalesce` pseudo module, timers set with a tolerance
+ * (see xtimer_set_slack()) are batched: the low-level timer is programmed for
+ * the latest time that still satisfies every pending timer's window, and all
+ * timers due by then fire in one callback sweep. This reduces wakeups and
+ * interrupt overhead for periodic housekeeping timers.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,8 +86,25 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_COALESCE) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may fire late, only
+                                     with xtimer_coalesce */
+#endif
 } xtimer_t;
 
+#if defined(MODULE_XTIMER_COALESCE) || defined(DOXYGEN)
+/**
+ * @brief xtimer_coalesce statistics
+ *
+ * Timers fired coalesced with others are `fired - sweeps`.
+ */
+typedef struct {
+    uint32_t sweeps;             /**< callback sweeps that fired timers, i.e.,
+                                     low-level timer interrupts */
+    uint32_t fired;              /**< number of timers fired */
+} xtimer_coalesce_stats_t;
+#endif
+
 /**
  * @brief get the current system time as 32bit time stamp value
  *
@@ -225,6 +254,24 @@ static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup, uint32_
  */
 static inline void xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 
+/**
+ * @brief Set a timer that sends a message, with a tolerance
+ *
+ * Like xtimer_set_msg(), but the message may be sent up to @p slack
+ * microseconds late (see xtimer_set_slack()).
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use.
+ * @param[in] offset        microseconds from now
+ * @param[in] slack         microseconds the message may be sent late
+ * @param[in] msg           ptr to msg that will be sent
+ * @param[in] target_pid    pid the message will be sent to
+ */
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid);
+
 /**
  * @brief Set a timer that sends a message, 64bit version
  *
@@ -291,6 +338,28 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer to execute a callback at some time in the future, with
+ * a tolerance
+ *
+ * Like xtimer_set(), but the callback may be executed up to @p slack
+ * microseconds after @p offset. With the `xtimer_coalesce` module, xtimer
+ * uses this window to fire all timers whose windows overlap with a single
+ * low-level timer interrupt. Without it, @p slack is ignored.
+ *
+ * Use this for housekeeping timers that don't need to be precise.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    time in microseconds from now specifying that timer's
+ *                      callback's earliest execution time
+ * @param[in] slack     time in microseconds the callback's execution may be
+ *                      delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
 /**
  * @brief Set a timer to execute a callback at some time in the future, 64bit
  * version
@@ -312,6 +381,15 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
  */
 static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
 
+#if defined(MODULE_XTIMER_COALESCE) || defined(DOXYGEN)
+/**
+ * @brief Get the xtimer_coalesce statistics
+ *
+ * @param[out] stats    the statistics
+ */
+void xtimer_coalesce_stats(xtimer_coalesce_stats_t *stats);
+#endif
+
 /**
  * @brief remove a timer
  *
@@ -541,6 +619,36 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_WHEEL_SHIFT
+/**
+ * @brief   Width of a level 0 bucket of the `xtimer_wheel` backend, as power
+ *          of two of hardware ticks
+ *
+ * Timers expiring within the current level 0 bucket are kept in a sorted
+ * list, so this trades insertion cost against the number of cascades.
+ */
+#define XTIMER_WHEEL_SHIFT      (8U)
+#endif
+
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   Number of buckets per level of the `xtimer_wheel` backend, as
+ *          power of two (max. 5)
+ */
+#define XTIMER_WHEEL_BITS       (5U)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the `xtimer_wheel` backend
+ *
+ * Timers further than 2^(XTIMER_WHEEL_SHIFT + XTIMER_WHEEL_LEVELS *
+ * XTIMER_WHEEL_BITS) ticks in the future are kept in an unsorted overflow
+ * list. With the defaults this is ~76h at 1MHz.
+ */
+#define XTIMER_WHEEL_LEVELS     (6U)
+#endif
+
 /*
  * Default xtimer configuration
  */
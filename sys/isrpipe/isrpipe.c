@@ -22,15 +22,28 @@
 #include "isrpipe.h"
 #include "xtimer.h"
 
+/* lfring needs C11 atomics, so architectures without them keep using tsrb */
+#ifdef MODULE_LFRING
+#define _rb_init(rb, buf, size)     lfring_init(rb, (uint8_t *)(buf), size)
+#define _rb_add_one(rb, c)          lfring_add_one(rb, (uint8_t)(c))
+#define _rb_add                     lfring_add
+#define _rb_get                     lfring_get
+#else
+#define _rb_init                    tsrb_init
+#define _rb_add_one                 tsrb_add_one
+#define _rb_add                     tsrb_add
+#define _rb_get                     tsrb_get
+#endif
+
 void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize)
 {
     mutex_init(&isrpipe->mutex);
-    tsrb_init(&isrpipe->tsrb, buf, bufsize);
+    _rb_init(&isrpipe->rb, buf, bufsize);
 }
 
 int isrpipe_write_one(isrpipe_t *isrpipe, char c)
 {
-    int res = tsrb_add_one(&isrpipe->tsrb, c);
+    int res = _rb_add_one(&isrpipe->rb, c);
 
     /* `res` is either 0 on success or -1 when the buffer is full. Either way,
      * unlocking the mutex is fine.
@@ -40,11 +53,20 @@ int isrpipe_write_one(isrpipe_t *isrpipe, char c)
     return res;
 }
 
+int isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count)
+{
+    int res = _rb_add(&isrpipe->rb, buf, count);
+
+    mutex_unlock(&isrpipe->mutex);
+
+    return res;
+}
+
 int isrpipe_read(isrpipe_t *isrpipe, char *buffer, size_t count)
 {
     int res;
 
-    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
+    while (!(res = _rb_get(&isrpipe->rb, buffer, count))) {
         mutex_lock(&isrpipe->mutex);
     }
     return res;
@@ -72,7 +94,7 @@ int isrpipe_read_timeout(isrpipe_t *isrpipe, char *buffer, size_t count, uint32_
     xtimer_t timer = { .callback = _cb, .arg = &_timeout };
 
     xtimer_set(&timer, timeout);
-    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
+    while (!(res = _rb_get(&isrpipe->rb, buffer, count))) {
         mutex_lock(&isrpipe->mutex);
         if (_timeout.flag) {
             res = -ETIMEDOUT;
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_lfring
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ring buffer implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "lfring.h"
+
+/* The single producer rings share their implementation, parametrized by the
+ * element size. Every counter is only written by one side: `writes` by the
+ * producer, `reads` by the consumer. Release stores on these counters publish
+ * the copied data (producer) or the freed space (consumer). */
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static size_t _write_span(unsigned size, atomic_uint *reads,
+                          atomic_uint *writes, unsigned *idx)
+{
+    unsigned w = atomic_load_explicit(writes, memory_order_relaxed);
+    unsigned r = atomic_load_explicit(reads, memory_order_acquire);
+
+    *idx = w & (size - 1);
+    return _min(size - (w - r), size - *idx);
+}
+
+static size_t _read_span(unsigned size, atomic_uint *reads,
+                         atomic_uint *writes, unsigned *idx)
+{
+    unsigned r = atomic_load_explicit(reads, memory_order_relaxed);
+    unsigned w = atomic_load_explicit(writes, memory_order_acquire);
+
+    *idx = r & (size - 1);
+    return _min(w - r, size - *idx);
+}
+
+static inline void _advance(atomic_uint *counter, size_t n)
+{
+    unsigned val = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, val + n, memory_order_release);
+}
+
+static size_t _add(uint8_t *buf, unsigned size, atomic_uint *reads,
+                   atomic_uint *writes, size_t esize,
+                   const uint8_t *src, size_t n)
+{
+    size_t done = 0;
+
+    /* at most two spans: up to the end of the buffer and from its start */
+    for (unsigned i = 0; (i < 2) && (done < n); i++) {
+        unsigned idx;
+        size_t len = _min(_write_span(size, reads, writes, &idx), n - done);
+        if (len == 0) {
+            break;
+        }
+        memcpy(buf + (idx * esize), src + (done * esize), len * esize);
+        _advance(writes, len);
+        done += len;
+    }
+    return done;
+}
+
+static size_t _get(uint8_t *buf, unsigned size, atomic_uint *reads,
+                   atomic_uint *writes, size_t esize, uint8_t *dst, size_t n)
+{
+    size_t done = 0;
+
+    for (unsigned i = 0; (i < 2) && (done < n); i++) {
+        unsigned idx;
+        size_t len = _min(_read_span(size, reads, writes, &idx), n - done);
+        if (len == 0) {
+            break;
+        }
+        if (dst) {
+            memcpy(dst + (done * esize), buf + (idx * esize), len * esize);
+        }
+        _advance(reads, len);
+        done += len;
+    }
+    return done;
+}
+
+int lfring_add_one(lfring_t *rb, uint8_t c)
+{
+    return (lfring_add(rb, &c, 1) == 1) ? 0 : -1;
+}
+
+size_t lfring_add(lfring_t *rb, const void *src, size_t n)
+{
+    return _add(rb->buf, rb->size, &rb->reads, &rb->writes, 1, src, n);
+}
+
+int lfring_get_one(lfring_t *rb)
+{
+    uint8_t c;
+
+    return (lfring_get(rb, &c, 1) == 1) ? c : -1;
+}
+
+size_t lfring_get(lfring_t *rb, void *dst, size_t n)
+{
+    return _get(rb->buf, rb->size, &rb->reads, &rb->writes, 1, dst, n);
+}
+
+size_t lfring_drop(lfring_t *rb, size_t n)
+{
+    return _get(rb->buf, rb->size, &rb->reads, &rb->writes, 1, NULL, n);
+}
+
+size_t lfring_write_peek(lfring_t *rb, uint8_t **ptr)
+{
+    unsigned idx;
+    size_t len = _write_span(rb->size, &rb->reads, &rb->writes, &idx);
+
+    *ptr = &rb->buf[idx];
+    return len;
+}
+
+void lfring_write_commit(lfring_t *rb, size_t n)
+{
+    assert(n <= lfring_free(rb));
+    _advance(&rb->writes, n);
+}
+
+size_t lfring_read_peek(lfring_t *rb, const uint8_t **ptr)
+{
+    unsigned idx;
+    size_t len = _read_span(rb->size, &rb->reads, &rb->writes, &idx);
+
+    *ptr = &rb->buf[idx];
+    return len;
+}
+
+void lfring_read_commit(lfring_t *rb, size_t n)
+{
+    assert(n <= lfring_avail(rb));
+    _advance(&rb->reads, n);
+}
+
+int lfring_ptr_add_one(lfring_ptr_t *rb, void *ptr)
+{
+    return (lfring_ptr_add(rb, &ptr, 1) == 1) ? 0 : -1;
+}
+
+size_t lfring_ptr_add(lfring_ptr_t *rb, void *const *src, size_t n)
+{
+    return _add((uint8_t *)rb->buf, rb->size, &rb->reads, &rb->writes,
+                sizeof(void *), (const uint8_t *)src, n);
+}
+
+int lfring_ptr_get_one(lfring_ptr_t *rb, void **ptr)
+{
+    return (lfring_ptr_get(rb, ptr, 1) == 1) ? 0 : -1;
+}
+
+size_t lfring_ptr_get(lfring_ptr_t *rb, void **dst, size_t n)
+{
+    return _get((uint8_t *)rb->buf, rb->size, &rb->reads, &rb->writes,
+                sizeof(void *), (uint8_t *)dst, n);
+}
+
+size_t lfring_ptr_read_peek(lfring_ptr_t *rb, void *const **ptr)
+{
+    unsigned idx;
+    size_t len = _read_span(rb->size, &rb->reads, &rb->writes, &idx);
+
+    *ptr = &rb->buf[idx];
+    return len;
+}
+
+void lfring_ptr_read_commit(lfring_ptr_t *rb, size_t n)
+{
+    assert(n <= lfring_ptr_avail(rb));
+    _advance(&rb->reads, n);
+}
+
+/* The multi producer ring follows D. Vyukov's bounded queue: a slot is free
+ * for write number `pos` if its sequence number equals `pos`, and holds the
+ * element of write `pos` once the sequence number is `pos + 1`. Producers
+ * claim a write number by compare-and-swap on `writes`. */
+
+void lfring_mpsc_init(lfring_mpsc_t *rb, lfring_mpsc_slot_t *slots,
+                      unsigned size)
+{
+    assert((size != 0) && ((size & (size - 1)) == 0));
+    rb->slots = slots;
+    rb->size = size;
+    rb->reads = 0;
+    atomic_init(&rb->writes, 0);
+    for (unsigned i = 0; i < size; i++) {
+        atomic_init(&slots[i].seq, i);
+    }
+}
+
+int lfring_mpsc_add(lfring_mpsc_t *rb, void *ptr)
+{
+    unsigned pos = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+    lfring_mpsc_slot_t *slot;
+
+    while (1) {
+        slot = &rb->slots[pos & (rb->size - 1)];
+        int diff = (int)(atomic_load_explicit(&slot->seq, memory_order_acquire) -
+                         pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&rb->writes, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+            /* pos was updated by the failed exchange */
+        }
+        else if (diff < 0) {
+            /* slot still holds the element of the previous round */
+            return -1;
+        }
+        else {
+            pos = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+        }
+    }
+
+    slot->ptr = ptr;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+int lfring_mpsc_get_one(lfring_mpsc_t *rb, void **ptr)
+{
+    lfring_mpsc_slot_t *slot = &rb->slots[rb->reads & (rb->size - 1)];
+    unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+    if (seq != rb->reads + 1) {
+        return -1;
+    }
+    *ptr = slot->ptr;
+    /* free the slot for the write one round later */
+    atomic_store_explicit(&slot->seq, rb->reads + rb->size,
+                          memory_order_release);
+    rb->reads++;
+    return 0;
+}
+
+size_t lfring_mpsc_get(lfring_mpsc_t *rb, void **dst, size_t n)
+{
+    size_t done = 0;
+
+    while ((done < n) && (lfring_mpsc_get_one(rb, &dst[done]) == 0)) {
+        done++;
+    }
+    return done;
+}
@@ -565,6 +565,30 @@ static void _on_data(asymcute_con_t *con, size_t pkt_len, sock_udp_ep_t *remote)
     }
 }
 
+#ifdef MODULE_SOCK_ASYNC_EVENT
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    asymcute_con_t *con = (asymcute_con_t *)arg;
+
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        sock_udp_ep_t remote;
+        int n;
+
+        /* one event may stand for several queued packets, so drain the sock
+         * completely; a failed receive (e.g. -ENOBUFS) already dropped its
+         * packet */
+        while ((n = sock_udp_recv(sock, con->rxbuf, ASYMCUTE_BUFSIZE, 0,
+                                  &remote)) != -EAGAIN) {
+            if (n > 0) {
+                _on_data(con, (size_t)n, &remote);
+            }
+            else if (n < 0) {
+                LOG_ERROR("[asymcute] error while receiving UDP packet\n");
+            }
+        }
+    }
+}
+#else
 void *_listener(void *arg)
 {
     asymcute_con_t *con = (asymcute_con_t *)arg;
@@ -588,6 +612,7 @@ void *_listener(void *arg)
     /* should never be reached */
     return NULL;
 }
+#endif
 
 void *_handler(void *arg)
 {
@@ -624,6 +649,21 @@ int asymcute_listener_run(asymcute_con_t *con, char *stack, size_t stacksize,
     con->state = NOTCON;
     con->user_cb = callback;
 
+#ifdef MODULE_SOCK_ASYNC_EVENT
+    (void)stack;
+    (void)stacksize;
+    (void)priority;
+    /* the handler thread serves the socket, using an ephemeral port */
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    if (sock_udp_create(&con->sock, &local, NULL, 0) != 0) {
+        LOG_ERROR("[asymcute] error creating listener socket\n");
+        con->state = UNINITIALIZED;
+        ret = ASYMCUTE_NOTSUP;
+        goto end;
+    }
+    sock_udp_event_init(&con->sock, &con->sock_evt, &_queue, _on_sock_evt,
+                        con);
+#else
     /* start listener thread */
     thread_create(stack,
                   stacksize,
@@ -632,6 +672,7 @@ int asymcute_listener_run(asymcute_con_t *con, char *stack, size_t stacksize,
                   _listener,
                   con,
                   "asymcute_listener");
+#endif
 
 end:
     mutex_unlock(&con->lock);
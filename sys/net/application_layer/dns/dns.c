@@ -18,8 +18,16 @@
 #include <string.h>
 #include <stdio.h>
 
+#include "mutex.h"
+#include "random.h"
 #include "net/sock/udp.h"
 #include "net/sock/dns.h"
+#ifdef MODULE_SOCK_DNS_ASYNC
+#include "thread.h"
+#endif
+#ifdef MODULE_SOCK_DNS_CACHE
+#include "xtimer.h"
+#endif
 
 #ifdef RIOT_VERSION
 #include "byteorder.h"
@@ -28,9 +36,55 @@
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+#define DNS_FLAGS_RESPONSE  (0x8000)
+#define DNS_FLAGS_RCODE     (0x000f)
+#define DNS_RCODE_NXDOMAIN  (3)
+#define DNS_TYPE_SOA        (6)
+
+/**
+ * @brief   A query in flight, on the stack of the thread sending it
+ */
+typedef struct _dns_query {
+    struct _dns_query *next;
+    const char *domain_name;
+    int family;
+    struct _dns_waiter *waiters;    /**< threads waiting for the result */
+} _dns_query_t;
+
+/**
+ * @brief   A thread waiting for the result of a query sent by another thread
+ */
+typedef struct _dns_waiter {
+    struct _dns_waiter *next;
+    mutex_t done;                   /**< unlocked when res is set */
+    void *addr_out;
+    int res;
+} _dns_waiter_t;
+
+#ifdef MODULE_SOCK_DNS_CACHE
+typedef struct {
+    char domain_name[SOCK_DNS_MAX_NAME_LEN + 1];
+    uint8_t addr[16];
+    int res;                        /**< result of the query */
+    int family;
+    uint32_t expires;               /**< in seconds since boot, 0 if unused */
+} _dns_cache_entry_t;
+
+static _dns_cache_entry_t _cache[SOCK_DNS_CACHE_SIZE];
+#endif
+
+#ifdef MODULE_SOCK_DNS_ASYNC
+static char _async_stack[SOCK_DNS_ASYNC_STACKSIZE];
+static event_queue_t _async_queue;
+static mutex_t _async_ready = MUTEX_INIT_LOCKED;
+#endif
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+static mutex_t _lock = MUTEX_INIT;
+static _dns_query_t *_queries;
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -73,43 +127,98 @@ static unsigned _get_short(uint8_t *buf)
     return _tmp;
 }
 
-static size_t _skip_hostname(uint8_t *buf)
+static uint32_t _get_long(uint8_t *buf)
 {
-    uint8_t *bufpos = buf;
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return ntohl(_tmp);
+}
 
-    /* handle DNS Message Compression */
-    if (*bufpos >= 192) {
-        return 2;
-    }
+static size_t _skip_hostname(uint8_t *buf, uint8_t *end)
+{
+    uint8_t *bufpos = buf;
 
-    while(*bufpos) {
+    while ((bufpos < end) && *bufpos) {
+        /* handle DNS Message Compression */
+        if (*bufpos >= 192) {
+            return (bufpos - buf + 2);
+        }
         bufpos += *bufpos + 1;
     }
     return (bufpos - buf + 1);
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+/* returns the TTL of the first SOA record in the authority section, limited
+ * by its MINIMUM field, see RFC 2308, section 5; or 0 if there is none */
+static uint32_t _parse_soa_ttl(uint8_t *buf, uint8_t *bufpos, uint8_t *end)
+{
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
+
+    for (unsigned n = 0; n < ntohs(hdr->nscount); n++) {
+        bufpos += _skip_hostname(bufpos, end);
+        if ((bufpos + 10) > end) {
+            break;
+        }
+        uint16_t _type = ntohs(_get_short(bufpos));
+        uint32_t ttl = _get_long(bufpos + 4);
+        unsigned rdlen = ntohs(_get_short(bufpos + 8));
+        bufpos += 10;
+        if ((bufpos + rdlen) > end) {
+            break;
+        }
+        if (_type == DNS_TYPE_SOA) {
+            uint8_t *rdata = bufpos;
+
+            /* skip MNAME and RNAME, MINIMUM is the last of five 32-bit
+             * fields after them */
+            rdata += _skip_hostname(rdata, bufpos + rdlen);
+            rdata += _skip_hostname(rdata, bufpos + rdlen);
+            if ((rdata + 20) > (bufpos + rdlen)) {
+                break;
+            }
+            uint32_t minimum = _get_long(rdata + 16);
+            return (ttl < minimum) ? ttl : minimum;
+        }
+        bufpos += rdlen;
+    }
+    return 0;
+}
+
+static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family,
+                            uint32_t *ttl)
 {
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     uint8_t *bufpos = buf + sizeof(*hdr);
+    uint8_t *end = buf + len;
+
+    *ttl = 0;
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
-        bufpos += _skip_hostname(bufpos);
+        bufpos += _skip_hostname(bufpos, end);
         bufpos += 4;    /* skip type and class of query */
     }
 
+    if ((ntohs(hdr->flags) & DNS_FLAGS_RCODE) == DNS_RCODE_NXDOMAIN) {
+        *ttl = _parse_soa_ttl(buf, bufpos, end);
+        return -1;
+    }
+
     for (unsigned n = 0; n < ntohs(hdr->ancount); n++) {
-        bufpos += _skip_hostname(bufpos);
+        bufpos += _skip_hostname(bufpos, end);
+        if ((bufpos + 10) > end) {
+            return -EBADMSG;
+        }
         uint16_t _type = ntohs(_get_short(bufpos));
         bufpos += 2;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += 2;
-        bufpos += 4; /* skip ttl */
+        uint32_t _ttl = _get_long(bufpos);
+        bufpos += 4;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         bufpos += 2;
-        if ((bufpos + addrlen) > (buf + len)) {
+        if ((bufpos + addrlen) > end) {
             return -EBADMSG;
         }
 
@@ -124,28 +233,90 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        *ttl = _ttl;
         return addrlen;
     }
 
+    /* no record of the requested type: negative answer */
+    *ttl = _parse_soa_ttl(buf, bufpos, end);
     return -1;
 }
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
+#ifdef MODULE_SOCK_DNS_CACHE
+static uint32_t _now_sec(void)
 {
-    uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
-    uint8_t reply_buf[512];
+    /* 0 marks unused cache entries, so start at 1 */
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC) + 1;
+}
 
-    if (sock_dns_server.port == 0) {
-        return -ECONNREFUSED;
+/* returns the cached result of a query or 0 if there is none; must be called
+ * with _lock held */
+static int _cache_get(const char *domain_name, void *addr_out, int family)
+{
+    uint32_t now = _now_sec();
+
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _dns_cache_entry_t *entry = &_cache[i];
+
+        if ((entry->expires == 0) || (entry->family != family) ||
+            (strcmp(entry->domain_name, domain_name) != 0)) {
+            continue;
+        }
+        if ((int32_t)(entry->expires - now) <= 0) {
+            entry->expires = 0;
+            return 0;
+        }
+        if (entry->res > 0) {
+            memcpy(addr_out, entry->addr, entry->res);
+        }
+        return entry->res;
     }
+    return 0;
+}
 
-    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
-        return -ENOSPC;
+/* must be called with _lock held */
+static void _cache_add(const char *domain_name, const void *addr, int family,
+                       int res, uint32_t ttl)
+{
+    uint32_t now = _now_sec();
+    _dns_cache_entry_t *entry = &_cache[0];
+
+    if (ttl > SOCK_DNS_CACHE_TTL_MAX) {
+        ttl = SOCK_DNS_CACHE_TTL_MAX;
     }
+    /* take an unused or expired entry, otherwise the one expiring first */
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        if ((_cache[i].expires == 0) ||
+            ((int32_t)(_cache[i].expires - now) <= 0)) {
+            entry = &_cache[i];
+            break;
+        }
+        if ((int32_t)(_cache[i].expires - entry->expires) < 0) {
+            entry = &_cache[i];
+        }
+    }
+    strcpy(entry->domain_name, domain_name);
+    if (res > 0) {
+        memcpy(entry->addr, addr, res);
+    }
+    entry->res = res;
+    entry->family = family;
+    entry->expires = now + ttl;
+}
+#endif
+
+static int _query(const char *domain_name, void *addr_out, int family,
+                  uint32_t *ttl)
+{
+    uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
+    uint8_t reply_buf[512];
+
+    *ttl = 0;
 
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     memset(hdr, 0, sizeof(*hdr));
-    hdr->id = 0; /* random? */
+    /* a random ID makes it hard to spoof replies */
+    hdr->id = (uint16_t)random_uint32();
     hdr->flags = htons(0x0120);
     hdr->qdcount = htons(1 + (family == AF_UNSPEC));
 
@@ -174,8 +345,7 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
 
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
     if (res) {
-            puts("a");
-        goto out;
+        return res;
     }
 
     for (int i = 0; i < SOCK_DNS_RETRIES; i++) {
@@ -183,15 +353,175 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         if (res <= 0) {
             continue;
         }
-        res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf), 1000000LU, NULL);
-        if ((res > 0) && (res > (int)DNS_MIN_REPLY_LEN)) {
-            if ((res = _parse_dns_reply(reply_buf, res, addr_out, family)) > 0) {
-                goto out;
+        /* ignore replies to other queries */
+        do {
+            res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf),
+                                SOCK_DNS_TIMEOUT, NULL);
+        } while ((res > (int)DNS_MIN_REPLY_LEN) &&
+                 ((((sock_dns_hdr_t *)reply_buf)->id != hdr->id) ||
+                  !(ntohs(((sock_dns_hdr_t *)reply_buf)->flags) &
+                    DNS_FLAGS_RESPONSE)));
+        if (res > (int)DNS_MIN_REPLY_LEN) {
+            res = _parse_dns_reply(reply_buf, res, addr_out, family, ttl);
+            if (res != -EBADMSG) {
+                /* the server answered, even if negatively */
+                break;
             }
         }
     }
 
-out:
     sock_udp_close(&sock_dns);
     return res;
 }
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    _dns_query_t query = { .domain_name = domain_name, .family = family };
+    _dns_query_t *q;
+    uint32_t ttl;
+    int res;
+
+    if (sock_dns_server.port == 0) {
+        return -ECONNREFUSED;
+    }
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+
+    mutex_lock(&_lock);
+#ifdef MODULE_SOCK_DNS_CACHE
+    if ((res = _cache_get(domain_name, addr_out, family)) != 0) {
+        mutex_unlock(&_lock);
+        return res;
+    }
+#endif
+    /* share the result of the same query sent by another thread */
+    for (q = _queries; q != NULL; q = q->next) {
+        if ((q->family == family) &&
+            (strcmp(q->domain_name, domain_name) == 0)) {
+            _dns_waiter_t waiter = { .done = MUTEX_INIT_LOCKED,
+                                     .addr_out = addr_out };
+
+            waiter.next = q->waiters;
+            q->waiters = &waiter;
+            mutex_unlock(&_lock);
+            mutex_lock(&waiter.done);
+            return waiter.res;
+        }
+    }
+    query.next = _queries;
+    _queries = &query;
+    mutex_unlock(&_lock);
+
+    res = _query(domain_name, addr_out, family, &ttl);
+
+    mutex_lock(&_lock);
+#ifdef MODULE_SOCK_DNS_CACHE
+    if (ttl > 0) {
+        _cache_add(domain_name, addr_out, family, res, ttl);
+    }
+#else
+    (void)ttl;
+#endif
+    for (_dns_query_t **prev = &_queries; *prev != NULL;
+         prev = &(*prev)->next) {
+        if (*prev == &query) {
+            *prev = query.next;
+            break;
+        }
+    }
+    for (_dns_waiter_t *waiter = query.waiters; waiter != NULL;) {
+        /* the waiter is gone as soon as it is woken up */
+        _dns_waiter_t *next = waiter->next;
+
+        if (res > 0) {
+            memcpy(waiter->addr_out, addr_out, res);
+        }
+        waiter->res = res;
+        mutex_unlock(&waiter->done);
+        waiter = next;
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+#ifdef MODULE_SOCK_DNS_CACHE
+void sock_dns_cache_flush(void)
+{
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache[i].expires = 0;
+    }
+    mutex_unlock(&_lock);
+}
+#endif
+
+#ifdef MODULE_SOCK_DNS_ASYNC
+static void _async_handler(event_t *event)
+{
+    sock_dns_async_t *req = (sock_dns_async_t *)event;
+    int res = sock_dns_query(req->domain_name, req->addr, req->family);
+
+    req->cb(req, res);
+}
+
+static void *_async_thread(void *arg)
+{
+    (void)arg;
+    event_queue_init(&_async_queue);
+    mutex_unlock(&_async_ready);
+    event_loop(&_async_queue);
+    return NULL;
+}
+
+int sock_dns_query_async(sock_dns_async_t *req, const char *domain_name,
+                         int family, sock_dns_cb_t cb)
+{
+    static kernel_pid_t pid = KERNEL_PID_UNDEF;
+
+    if (sock_dns_server.port == 0) {
+        return -ECONNREFUSED;
+    }
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+
+    req->super.handler = _async_handler;
+    req->domain_name = domain_name;
+    req->family = family;
+    req->cb = cb;
+#ifdef MODULE_SOCK_DNS_CACHE
+    int res;
+
+    mutex_lock(&_lock);
+    res = _cache_get(domain_name, req->addr, family);
+    mutex_unlock(&_lock);
+    if (res != 0) {
+        cb(req, res);
+        return 0;
+    }
+#endif
+    mutex_lock(&_lock);
+    if (pid == KERNEL_PID_UNDEF) {
+        kernel_pid_t new_pid = thread_create(_async_stack,
+                                             sizeof(_async_stack),
+                                             SOCK_DNS_ASYNC_PRIO,
+                                             THREAD_CREATE_STACKTEST,
+                                             _async_thread, NULL, "dns");
+
+        if (new_pid < 0) {
+            /* try again with the next query */
+            mutex_unlock(&_lock);
+            return -ENOMEM;
+        }
+        /* the queue must be ready before posting to it */
+        mutex_lock(&_async_ready);
+        pid = new_pid;
+    }
+    mutex_unlock(&_lock);
+    event_post(&_async_queue, &req->super);
+    return 0;
+}
+#endif
@@ -20,6 +20,7 @@
 
 #include <string.h>
 
+#include "irq.h"
 #include "log.h"
 #include "mutex.h"
 #include "sched.h"
@@ -28,8 +29,20 @@
 #include "thread_flags.h"
 
 #include "net/emcute.h"
+#ifdef MODULE_SOCK_ASYNC_EVENT
+#include "event/callback.h"
+#include "event/timeout.h"
+#include "net/sock/async_event.h"
+#endif
+#ifdef MODULE_EMCUTE_WINDOW
+#include "sema.h"
+#endif
 #include "emcute_internal.h"
 
+#if defined(MODULE_EMCUTE_WINDOW) && !defined(MODULE_SOCK_ASYNC_EVENT)
+#error "emcute_window needs sock_async_event for its retransmit timers"
+#endif
+
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
@@ -41,6 +54,7 @@
 #define TFLAGS_RESP         (0x0001)
 #define TFLAGS_TIMEOUT      (0x0002)
 #define TFLAGS_ANY          (TFLAGS_RESP | TFLAGS_TIMEOUT)
+#define TFLAGS_FLUSH        (0x0004)
 
 
 static const char *cli_id;
@@ -60,6 +74,35 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+#ifdef MODULE_SOCK_ASYNC_EVENT
+static event_queue_t queue;
+static sock_event_t sock_evt;
+static event_callback_t ping_evt;
+static event_timeout_t ping_timer;
+#endif
+
+#ifdef MODULE_EMCUTE_WINDOW
+/**
+ * @brief   A QoS 1 PUBLISH awaiting its PUBACK
+ */
+typedef struct {
+    event_callback_t retry_evt;
+    event_timeout_t retry_timer;
+    size_t len;                 /**< length of the packet, 0 if unused */
+    unsigned retries;
+    uint16_t id;                /**< message ID */
+    uint8_t flags_pos;          /**< position of the flags in buf */
+    uint8_t buf[EMCUTE_BUFSIZE];
+} inflight_t;
+
+static inflight_t inflight[EMCUTE_WINDOW_SIZE];
+static unsigned inflight_numof;
+static mutex_t winlock = MUTEX_INIT;
+static sema_t winsema = SEMA_CREATE(EMCUTE_WINDOW_SIZE);
+static int winresult = EMCUTE_OK;
+static thread_t *flusher;
+#endif
+
 static size_t set_len(uint8_t *buf, size_t len)
 {
     if (len < (0xff - 7)) {
@@ -68,7 +111,7 @@ static size_t set_len(uint8_t *buf, size_t len)
     }
     else {
         buf[0] = 0x01;
-        byteorder_htobebufs(&tbuf[1], (uint16_t)(len + 3));
+        byteorder_htobebufs(&buf[1], (uint16_t)(len + 3));
         return 3;
     }
 }
@@ -85,6 +128,34 @@ static size_t get_len(uint8_t *buf, uint16_t *len)
     }
 }
 
+/* message IDs are taken by the user threads, for windowed publishes without
+ * holding txlock */
+static uint16_t next_id(void)
+{
+    unsigned state = irq_disable();
+    uint16_t id = id_next++;
+
+    irq_restore(state);
+    return id;
+}
+
+/* writes a PUBLISH packet to buf, returns its length */
+static size_t set_pub(uint8_t *buf, const emcute_topic_t *topic,
+                      const void *data, size_t len, unsigned flags,
+                      uint16_t id)
+{
+    size_t pos = set_len(buf, (len + 6));
+
+    buf[pos++] = PUBLISH;
+    buf[pos++] = flags;
+    byteorder_htobebufs(&buf[pos], topic->id);
+    pos += 2;
+    byteorder_htobebufs(&buf[pos], id);
+    pos += 2;
+    memcpy(&buf[pos], data, len);
+    return pos + len;
+}
+
 static void time_evt(void *arg)
 {
     thread_flags_set((thread_t *)arg, TFLAGS_TIMEOUT);
@@ -147,6 +218,113 @@ static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
     }
 }
 
+#ifdef MODULE_EMCUTE_WINDOW
+/* frees a window slot; must be called with winlock held */
+static void window_done(inflight_t *slot, int res)
+{
+    event_timeout_clear(&slot->retry_timer);
+    /* the timeout might have fired already */
+    event_cancel(&queue, &slot->retry_evt.super);
+    slot->len = 0;
+    inflight_numof--;
+    if ((res != EMCUTE_OK) && (winresult == EMCUTE_OK)) {
+        winresult = res;
+    }
+    sema_post(&winsema);
+    if ((inflight_numof == 0) && (flusher != NULL)) {
+        thread_flags_set(flusher, TFLAGS_FLUSH);
+    }
+}
+
+static bool on_window_puback(void)
+{
+    uint16_t id = byteorder_bebuftohs(&rbuf[4]);
+    bool found = false;
+
+    mutex_lock(&winlock);
+    for (unsigned i = 0; i < EMCUTE_WINDOW_SIZE; i++) {
+        if ((inflight[i].len != 0) && (inflight[i].id == id)) {
+            window_done(&inflight[i],
+                        (rbuf[6] == ACCEPT) ? EMCUTE_OK : EMCUTE_REJECT);
+            found = true;
+            break;
+        }
+    }
+    mutex_unlock(&winlock);
+    return found;
+}
+
+static void on_window_retry(void *arg)
+{
+    inflight_t *slot = arg;
+
+    mutex_lock(&winlock);
+    if (slot->len != 0) {
+        if (gateway.port == 0) {
+            window_done(slot, EMCUTE_NOGW);
+        }
+        else if (slot->retries++ < EMCUTE_N_RETRY) {
+            DEBUG("[emcute] window: resending message %u\n",
+                  (unsigned)slot->id);
+            slot->buf[slot->flags_pos] |= EMCUTE_DUP;
+            sock_udp_send(&sock, slot->buf, slot->len, &gateway);
+            event_timeout_set(&slot->retry_timer,
+                              (EMCUTE_T_RETRY * US_PER_SEC));
+        }
+        else {
+            window_done(slot, EMCUTE_TIMEOUT);
+        }
+    }
+    mutex_unlock(&winlock);
+}
+
+static int window_pub(emcute_topic_t *topic, const void *data, size_t len,
+                      unsigned flags)
+{
+    inflight_t *slot = NULL;
+
+    /* blocks while the window is full */
+    sema_wait(&winsema);
+    mutex_lock(&winlock);
+    for (unsigned i = 0; i < EMCUTE_WINDOW_SIZE; i++) {
+        if (inflight[i].len == 0) {
+            slot = &inflight[i];
+            break;
+        }
+    }
+    assert(slot != NULL);
+    slot->id = next_id();
+    slot->len = set_pub(slot->buf, topic, data, len, flags, slot->id);
+    slot->flags_pos = (slot->buf[0] == 0x01) ? 4 : 2;
+    slot->retries = 0;
+    inflight_numof++;
+    /* the timer is started first, so a PUBACK always finds it set */
+    event_timeout_set(&slot->retry_timer, (EMCUTE_T_RETRY * US_PER_SEC));
+    sock_udp_send(&sock, slot->buf, slot->len, &gateway);
+    mutex_unlock(&winlock);
+    return EMCUTE_OK;
+}
+
+int emcute_flush(void)
+{
+    int res;
+
+    mutex_lock(&winlock);
+    flusher = (thread_t *)sched_active_thread;
+    thread_flags_clear(TFLAGS_FLUSH);
+    while (inflight_numof > 0) {
+        mutex_unlock(&winlock);
+        thread_flags_wait_any(TFLAGS_FLUSH);
+        mutex_lock(&winlock);
+    }
+    flusher = NULL;
+    res = winresult;
+    winresult = EMCUTE_OK;
+    mutex_unlock(&winlock);
+    return res;
+}
+#endif
+
 static void on_publish(size_t len, size_t pos)
 {
     /* make sure packet length is valid - if not, drop packet silently */
@@ -312,8 +490,8 @@ int emcute_reg(emcute_topic_t *topic)
     tbuf[0] = (strlen(topic->name) + 6);
     tbuf[1] = REGISTER;
     byteorder_htobebufs(&tbuf[2], 0);
-    byteorder_htobebufs(&tbuf[4], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    byteorder_htobebufs(&tbuf[4], waitonid);
     memcpy(&tbuf[6], topic->name, strlen(topic->name));
 
     int res = syncsend(REGACK, (size_t)tbuf[0], true);
@@ -341,18 +519,16 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
         return EMCUTE_NOTSUP;
     }
 
+#ifdef MODULE_EMCUTE_WINDOW
+    if (flags & EMCUTE_QOS_1) {
+        return window_pub(topic, data, len, flags);
+    }
+#endif
+
     mutex_lock(&txlock);
 
-    size_t pos = set_len(tbuf, (len + 6));
-    len += (pos + 6);
-    tbuf[pos++] = PUBLISH;
-    tbuf[pos++] = flags;
-    byteorder_htobebufs(&tbuf[pos], topic->id);
-    pos += 2;
-    byteorder_htobebufs(&tbuf[pos], id_next);
-    waitonid = id_next++;
-    pos += 2;
-    memcpy(&tbuf[pos], data, len);
+    waitonid = next_id();
+    len = set_pub(tbuf, topic, data, len, flags, waitonid);
 
     if (flags & EMCUTE_QOS_1) {
         res = syncsend(PUBACK, len, true);
@@ -381,8 +557,8 @@ int emcute_sub(emcute_sub_t *sub, unsigned flags)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = SUBSCRIBE;
     tbuf[2] = flags;
-    byteorder_htobebufs(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    byteorder_htobebufs(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(SUBACK, (size_t)tbuf[0], false);
@@ -417,8 +593,8 @@ int emcute_unsub(emcute_sub_t *sub)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = UNSUBSCRIBE;
     tbuf[2] = 0;
-    byteorder_htobebufs(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    byteorder_htobebufs(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(UNSUBACK, (size_t)tbuf[0], false);
@@ -488,23 +664,122 @@ int emcute_willupd_msg(const void *data, size_t len)
     return syncsend(WILLMSGRESP, len, true);
 }
 
+static void on_pkt(size_t len, sock_udp_ep_t *remote)
+{
+    uint16_t pkt_len;
+
+    if (len < 2) {
+        return;
+    }
+    /* catch invalid length field */
+    if ((len == 2) && (rbuf[0] == 0x01)) {
+        return;
+    }
+    /* parse length field */
+    size_t pos = get_len(rbuf, &pkt_len);
+    /* verify length to prevent overflows */
+    if (((size_t)pkt_len > len) || (pos >= len)) {
+        return;
+    }
+    /* get packet type */
+    uint8_t type = rbuf[pos];
+
+    switch (type) {
+        case CONNACK:       on_ack(type, 0, 2, 0);              break;
+        case WILLTOPICREQ:  on_ack(type, 0, 0, 0);              break;
+        case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
+        case REGACK:        on_ack(type, 4, 6, 2);              break;
+        case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
+        case PUBACK:
+#ifdef MODULE_EMCUTE_WINDOW
+            if (on_window_puback()) {
+                break;
+            }
+#endif
+            on_ack(type, 4, 6, 0);
+            break;
+        case SUBACK:        on_ack(type, 5, 7, 3);              break;
+        case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
+        case PINGREQ:       on_pingreq(remote);                 break;
+        case PINGRESP:      on_pingresp();                      break;
+        case DISCONNECT:    on_disconnect();                    break;
+        case WILLTOPICRESP: on_ack(type, 0, 0, 0);              break;
+        case WILLMSGRESP:   on_ack(type, 0, 0, 0);              break;
+        default:
+            LOG_DEBUG("[emcute] received unexpected type [%s]\n",
+                      emcute_type_str(type));
+    }
+}
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+static void on_sock_evt(sock_udp_t *s, sock_async_flags_t type, void *arg)
+{
+    (void)arg;
+
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        sock_udp_ep_t remote;
+        ssize_t len;
+
+        /* one event may stand for several queued packets, so drain the sock
+         * completely; a failed receive (e.g. -ENOBUFS) already dropped its
+         * packet */
+        while ((len = sock_udp_recv(s, rbuf, sizeof(rbuf), 0,
+                                    &remote)) != -EAGAIN) {
+            if (len >= 0) {
+                on_pkt((size_t)len, &remote);
+            }
+            else {
+                LOG_ERROR("[emcute] error while receiving UDP packet\n");
+            }
+        }
+    }
+}
+
+static void on_keepalive(void *arg)
+{
+    (void)arg;
+
+    send_ping();
+    event_timeout_set(&ping_timer, (EMCUTE_KEEPALIVE * US_PER_SEC));
+}
+#endif
+
 void emcute_run(uint16_t port, const char *id)
 {
     assert(strlen(id) < EMCUTE_ID_MAXLEN);
 
     sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
-    sock_udp_ep_t remote;
     local.port = port;
     cli_id = id;
     timer.callback = time_evt;
     timer.arg = NULL;
     mutex_init(&txlock);
 
+#ifdef MODULE_SOCK_ASYNC_EVENT
+    /* the queue must be ready before the sock can post to it */
+    event_queue_init(&queue);
+#endif
     if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
         LOG_ERROR("[emcute] unable to open UDP socket on port %i\n", (int)port);
         return;
     }
 
+#ifdef MODULE_SOCK_ASYNC_EVENT
+    sock_udp_event_init(&sock, &sock_evt, &queue, on_sock_evt, NULL);
+    event_callback_init(&ping_evt, on_keepalive, NULL);
+    event_timeout_init(&ping_timer, &queue, &ping_evt.super);
+    event_timeout_set(&ping_timer, (EMCUTE_KEEPALIVE * US_PER_SEC));
+#ifdef MODULE_EMCUTE_WINDOW
+    for (unsigned i = 0; i < EMCUTE_WINDOW_SIZE; i++) {
+        event_callback_init(&inflight[i].retry_evt, on_window_retry,
+                            &inflight[i]);
+        event_timeout_init(&inflight[i].retry_timer, &queue,
+                           &inflight[i].retry_evt.super);
+    }
+#endif
+    event_loop(&queue);
+#else
+    sock_udp_ep_t remote;
     uint32_t start = xtimer_now_usec();
     uint32_t t_out = (EMCUTE_KEEPALIVE * US_PER_SEC);
 
@@ -516,40 +791,8 @@ void emcute_run(uint16_t port, const char *id)
             return;
         }
 
-        if (len >= 2) {
-            /* handle the packet */
-            uint16_t pkt_len;
-            /* catch invalid length field */
-            if ((len == 2) && (rbuf[0] == 0x01)) {
-                continue;
-            }
-            /* parse length field */
-            size_t pos = get_len(rbuf, &pkt_len);
-            /* verify length to prevent overflows */
-            if (((size_t)pkt_len > (size_t)len) || (pos >= (size_t)len)) {
-                continue;
-            }
-            /* get packet type */
-            uint8_t type = rbuf[pos];
-
-            switch (type) {
-                case CONNACK:       on_ack(type, 0, 2, 0);              break;
-                case WILLTOPICREQ:  on_ack(type, 0, 0, 0);              break;
-                case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
-                case REGACK:        on_ack(type, 4, 6, 2);              break;
-                case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
-                case PUBACK:        on_ack(type, 4, 6, 0);              break;
-                case SUBACK:        on_ack(type, 5, 7, 3);              break;
-                case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
-                case PINGREQ:       on_pingreq(&remote);                break;
-                case PINGRESP:      on_pingresp();                      break;
-                case DISCONNECT:    on_disconnect();                    break;
-                case WILLTOPICRESP: on_ack(type, 0, 0, 0);              break;
-                case WILLMSGRESP:   on_ack(type, 0, 0, 0);              break;
-                default:
-                    LOG_DEBUG("[emcute] received unexpected type [%s]\n",
-                              emcute_type_str(type));
-            }
+        if (len >= 0) {
+            on_pkt((size_t)len, &remote);
         }
 
         uint32_t now = xtimer_now_usec();
@@ -562,4 +805,5 @@ void emcute_run(uint16_t port, const char *id)
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
     }
+#endif
 }
@@ -13,7 +13,8 @@
  * @file
  * @brief       GNRC's implementation of CoAP protocol
  *
- * Runs a thread (_pid) to manage request/response messaging.
+ * Runs a thread (_pid) handling an event queue to manage request/response
+ * messaging.
  *
  * @author      Ken Bannister <kb2ma@runbox.com>
  */
@@ -24,6 +25,7 @@
 
 #include "assert.h"
 #include "net/gcoap.h"
+#include "net/sock/async_event.h"
 #include "net/sock/util.h"
 #include "mutex.h"
 #include "random.h"
@@ -32,6 +34,13 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if (GCOAP_REQ_HASH_BUCKETS & (GCOAP_REQ_HASH_BUCKETS - 1)) != 0
+#error "GCOAP_REQ_HASH_BUCKETS must be a power of two"
+#endif
+#if (GCOAP_OBS_HASH_BUCKETS & (GCOAP_OBS_HASH_BUCKETS - 1)) != 0
+#error "GCOAP_OBS_HASH_BUCKETS must be a power of two"
+#endif
+
 /* Return values used by the _find_resource function. */
 #define GCOAP_RESOURCE_FOUND 0
 #define GCOAP_RESOURCE_WRONG_METHOD -1
@@ -39,22 +48,32 @@
 
 /* Internal functions */
 static void *_event_loop(void *arg);
-static void _listen(sock_udp_t *sock);
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg);
+static void _on_resp_timeout(void *arg);
+static ssize_t _listen(sock_udp_t *sock);
+static void _process_pdu(sock_udp_t *sock, uint8_t *data, size_t len,
+                         sock_udp_ep_t *remote);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static void _expire_request(gcoap_request_memo_t *memo);
+static void _free_req_memo(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
 static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu);
+static void _find_observer(sock_udp_ep_t **observer, const sock_udp_ep_t *remote);
+static sock_udp_ep_t *_add_observer(const sock_udp_ep_t *remote);
+static void _find_obs_memo(gcoap_observe_memo_t **memo,
+                           const sock_udp_ep_t *observer, coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource);
+                                   const coap_resource_t *resource,
+                                   const sock_udp_ep_t *observer);
+static void _link_obs_memo(gcoap_observe_memo_t *memo);
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo);
+static void _free_obs_memo(gcoap_observe_memo_t *memo);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -82,9 +101,32 @@ typedef struct {
     gcoap_observe_memo_t observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
                                         /* Observed resource registrations */
     uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
-                                        /* Buffers for PDU for request resends;
-                                           if first byte of an entry is zero,
-                                           the entry is available */
+                                        /* Buffers for PDU for request resends */
+    /* Hash tables and pools for the arrays above. Buckets and chain links
+     * hold the index of an entry plus 1, 0 ends a chain. Each pool is a
+     * stack of the indices of the unused entries. */
+    uint16_t req_buckets[GCOAP_REQ_HASH_BUCKETS];
+                                        /* Open requests, by token */
+    uint16_t req_next[GCOAP_REQ_WAITING_MAX];
+    uint16_t req_pool[GCOAP_REQ_WAITING_MAX];
+    unsigned req_pool_numof;
+    uint16_t resend_buf_pool[GCOAP_RESEND_BUFS_MAX];
+    unsigned resend_buf_pool_numof;
+    uint16_t observer_buckets[GCOAP_OBS_HASH_BUCKETS];
+                                        /* Observers, by endpoint */
+    uint16_t observer_next[GCOAP_OBS_CLIENTS_MAX];
+    uint16_t observer_refs[GCOAP_OBS_CLIENTS_MAX];
+                                        /* Observe memos per observer */
+    uint16_t observer_pool[GCOAP_OBS_CLIENTS_MAX];
+    unsigned observer_pool_numof;
+    uint16_t obs_token_buckets[GCOAP_OBS_HASH_BUCKETS];
+                                        /* Observe memos, by token */
+    uint16_t obs_token_next[GCOAP_OBS_REGISTRATIONS_MAX];
+    uint16_t obs_resource_buckets[GCOAP_OBS_HASH_BUCKETS];
+                                        /* Observe memos, by resource */
+    uint16_t obs_resource_next[GCOAP_OBS_REGISTRATIONS_MAX];
+    uint16_t obs_memo_pool[GCOAP_OBS_REGISTRATIONS_MAX];
+    unsigned obs_memo_pool_numof;
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -93,17 +135,107 @@ static gcoap_state_t _coap_state = {
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
-static msg_t _msg_queue[GCOAP_MSG_QUEUE_SIZE];
+static event_queue_t _queue;
 static sock_udp_t _sock;
+static sock_event_t _sock_event;
 
+/* Adds the entry with index idx to the chain starting at bucket. */
+static void _chain_add(uint16_t *bucket, uint16_t *next, unsigned idx)
+{
+    next[idx] = *bucket;
+    *bucket   = idx + 1;
+}
 
-/* Event/Message loop for gcoap _pid thread. */
+/* Removes the entry with index idx from the chain starting at bucket, if it
+ * is in there. */
+static void _chain_remove(uint16_t *bucket, uint16_t *next, unsigned idx)
+{
+    while ((*bucket != 0) && (*bucket != (idx + 1))) {
+        bucket = &next[*bucket - 1];
+    }
+    if (*bucket != 0) {
+        *bucket = next[idx];
+    }
+}
+
+/* Fills a pool with the indices of all entries of its array. */
+static void _pool_init(uint16_t *pool, unsigned *numof, unsigned size)
+{
+    for (unsigned i = 0; i < size; i++) {
+        /* hand out the first entries first */
+        pool[i] = size - 1 - i;
+    }
+    *numof = size;
+}
+
+/* Takes an index from a pool; returns -1 if the pool is empty. */
+static int _pool_get(uint16_t *pool, unsigned *numof)
+{
+    return (*numof > 0) ? pool[--(*numof)] : -1;
+}
+
+static void _pool_put(uint16_t *pool, unsigned *numof, unsigned idx)
+{
+    pool[(*numof)++] = idx;
+}
+
+static unsigned _hash_token(const uint8_t *token, unsigned token_len)
+{
+    unsigned hash = token_len;
+
+    /* tokens are random, so folding them is enough */
+    for (unsigned i = 0; i < token_len; i++) {
+        hash = (hash << 3) ^ (hash >> 5) ^ token[i];
+    }
+    return hash ^ (hash >> 8);
+}
+
+static uint16_t *_req_bucket(const uint8_t *token, unsigned token_len)
+{
+    return &_coap_state.req_buckets[_hash_token(token, token_len) &
+                                    (GCOAP_REQ_HASH_BUCKETS - 1)];
+}
+
+/* Returns the header of the request a memo was created for. */
+static coap_hdr_t *_req_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+static uint16_t *_observer_bucket(const sock_udp_ep_t *ep)
+{
+    /* the port and the end of the address differ between clients */
+    unsigned hash = ep->port ^ (ep->addr.ipv6[14] << 8) ^ ep->addr.ipv6[15];
+
+    return &_coap_state.observer_buckets[(hash ^ (hash >> 8)) &
+                                         (GCOAP_OBS_HASH_BUCKETS - 1)];
+}
+
+static uint16_t *_obs_token_bucket(const uint8_t *token, unsigned token_len)
+{
+    return &_coap_state.obs_token_buckets[_hash_token(token, token_len) &
+                                          (GCOAP_OBS_HASH_BUCKETS - 1)];
+}
+
+static uint16_t *_obs_resource_bucket(const coap_resource_t *resource)
+{
+    /* resources are elements of arrays */
+    uintptr_t hash = (uintptr_t)resource / sizeof(coap_resource_t);
+
+    return &_coap_state.obs_resource_buckets[(hash ^ (hash >> 8)) &
+                                             (GCOAP_OBS_HASH_BUCKETS - 1)];
+}
+
+
+/* Event loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
-    msg_t msg_rcvd;
     (void)arg;
 
-    msg_init_queue(_msg_queue, GCOAP_MSG_QUEUE_SIZE);
+    event_queue_init(&_queue);
 
     sock_udp_ep_t local;
     memset(&local, 0, sizeof(sock_udp_ep_t));
@@ -116,80 +248,96 @@ static void *_event_loop(void *arg)
         DEBUG("gcoap: cannot create sock: %d\n", res);
         return 0;
     }
+    sock_udp_event_init(&_sock, &_sock_event, &_queue, _on_sock_evt, NULL);
 
-    while(1) {
-        res = msg_try_receive(&msg_rcvd);
+    event_loop(&_queue);
 
-        if (res > 0) {
-            switch (msg_rcvd.type) {
-            case GCOAP_MSG_TYPE_TIMEOUT: {
-                gcoap_request_memo_t *memo = (gcoap_request_memo_t *)msg_rcvd.content.ptr;
+    return 0;
+}
 
-                /* no retries remaining */
-                if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
-                        || (memo->send_limit == 0)) {
-                    _expire_request(memo);
-                }
-                /* reduce retries remaining, double timeout and resend */
-                else {
-                    memo->send_limit--;
-                    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
-                    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
-                    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
-                    timeout = random_uint32_range(timeout, timeout + variance);
-
-                    ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
-                                                  memo->msg.data.pdu_len,
-                                                  &memo->remote_ep);
-                    if (bytes > 0) {
-                        xtimer_set_msg(&memo->response_timer, timeout,
-                                       &memo->timeout_msg, _pid);
-                    }
-                    else {
-                        DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
-                        _expire_request(memo);
-                    }
-                }
-                break;
-            }
-            default:
-                break;
-            }
-        }
+/* Handles sock events on the gcoap thread. */
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)arg;
 
-        _listen(&_sock);
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        /* one event may stand for several queued messages, so drain the sock
+         * completely; nothing else would wake us for the remaining ones */
+        while (_listen(sock) != -EAGAIN) {}
     }
+}
 
-    return 0;
+/* Handles the expiry of a request memo's response timer on the gcoap
+ * thread. */
+static void _on_resp_timeout(void *arg)
+{
+    gcoap_request_memo_t *memo = arg;
+
+    /* no retries remaining */
+    if ((memo->send_limit == GCOAP_SEND_LIMIT_NON) || (memo->send_limit == 0)) {
+        _expire_request(memo);
+    }
+    /* reduce retries remaining, double timeout and resend */
+    else {
+        memo->send_limit--;
+        unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
+        uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
+        uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
+        timeout = random_uint32_range(timeout, timeout + variance);
+
+        ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
+                                      memo->msg.data.pdu_len,
+                                      &memo->remote_ep);
+        if (bytes > 0) {
+            event_timeout_set(&memo->resp_tmout, timeout);
+        }
+        else {
+            DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
+            _expire_request(memo);
+        }
+    }
 }
 
-/* Listen for an incoming CoAP message. */
-static void _listen(sock_udp_t *sock)
+/*
+ * Handles an incoming CoAP message, if one is queued for the sock.
+ *
+ * return length of the message, -EAGAIN if no message is queued, or another
+ *        value < 0 if the message could not be received
+ */
+static ssize_t _listen(sock_udp_t *sock)
 {
-    coap_pkt_t pdu;
-    uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
-    gcoap_request_memo_t *memo = NULL;
-    uint8_t open_reqs = gcoap_op_state();
-
-    /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
-     * is interrupted when sending a message in gcoap_req_send2(). While a
-     * request is outstanding, sock_udp_recv() is called here with limited
-     * waiting so the request's timeout can be handled in a timely manner in
-     * _event_loop(). */
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
+    void *data, *buf_ctx = NULL;
+
+    ssize_t res = sock_udp_recv_buf(sock, &data, &buf_ctx, 0, &remote);
     if (res <= 0) {
 #if ENABLE_DEBUG
-        if (res < 0 && res != -ETIMEDOUT) {
-            DEBUG("gcoap: udp recv failure: %d\n", res);
+        if (res < 0 && res != -EAGAIN) {
+            DEBUG("gcoap: udp recv failure: %d\n", (int)res);
         }
 #endif
-        return;
+        return res;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    _process_pdu(sock, data, res, &remote);
+    /* release receive buffer; gnrc_sock provides a message in one chunk */
+    while (sock_udp_recv_buf(sock, &data, &buf_ctx, 0, NULL) > 0) {}
+    return res;
+}
+
+/*
+ * Handles an incoming CoAP message in the receive buffer of the network stack.
+ * The buffer is read-only, so a response to a request is built in a buffer on
+ * the stack.
+ */
+static void _process_pdu(sock_udp_t *sock, uint8_t *data, size_t len,
+                         sock_udp_ep_t *remote)
+{
+    coap_pkt_t pdu;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    gcoap_request_memo_t *memo = NULL;
+
+    ssize_t res = coap_parse(&pdu, data, len);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
@@ -207,9 +355,25 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_REQ:
         if (coap_get_type(&pdu) == COAP_TYPE_NON
                 || coap_get_type(&pdu) == COAP_TYPE_CON) {
-            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+            size_t hdr_len = pdu.payload - (uint8_t *)pdu.hdr;
+
+            if (hdr_len > sizeof(buf)) {
+                DEBUG("gcoap: request header too long: %u\n",
+                      (unsigned)hdr_len);
+                break;
+            }
+            /* the response is built in place of the request header, so only
+             * header and options are copied; the payload stays in the
+             * receive buffer */
+            memcpy(buf, pdu.hdr, hdr_len);
+            if (pdu.token != NULL) {
+                pdu.token = buf + (pdu.token - (uint8_t *)pdu.hdr);
+            }
+            pdu.hdr = (coap_hdr_t *)buf;
+
+            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), remote);
             if (pdu_len > 0) {
-                ssize_t bytes = sock_udp_send(sock, buf, pdu_len, &remote);
+                ssize_t bytes = sock_udp_send(sock, buf, pdu_len, remote);
                 if (bytes <= 0) {
                     DEBUG("gcoap: send response failed: %d\n", (int)bytes);
                 }
@@ -224,21 +388,22 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_SUCCESS:
     case COAP_CLASS_CLIENT_FAILURE:
     case COAP_CLASS_SERVER_FAILURE:
-        _find_req_memo(&memo, &pdu, &remote);
+        _find_req_memo(&memo, &pdu, remote);
         if (memo) {
             switch (coap_get_type(&pdu)) {
             case COAP_TYPE_NON:
             case COAP_TYPE_ACK:
-                xtimer_remove(&memo->response_timer);
+                event_timeout_clear(&memo->resp_tmout);
+                /* the timeout might have fired already */
+                event_cancel(&_queue, &memo->resp_evt.super);
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
-                    memo->resp_handler(memo->state, &pdu, &remote);
+                    memo->resp_handler(memo->state, &pdu, remote);
                 }
 
-                if (memo->send_limit >= 0) {        /* if confirmable */
-                    *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                }
-                memo->state = GCOAP_MEMO_UNUSED;
+                mutex_lock(&_coap_state.lock);
+                _free_req_memo(memo);
+                mutex_unlock(&_coap_state.lock);
                 break;
             case COAP_TYPE_CON:
                 DEBUG("gcoap: separate CON response not handled yet\n");
@@ -279,14 +444,26 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         case GCOAP_RESOURCE_NO_PATH:
             return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
         case GCOAP_RESOURCE_FOUND:
-            /* find observe registration for resource */
-            _find_obs_memo_resource(&resource_memo, resource);
             break;
     }
 
+    /* observe registrations may be looked up concurrently by
+     * gcoap_obs_init() and gcoap_obs_send() */
+    mutex_lock(&_coap_state.lock);
+    _find_observer(&observer, remote);
+    /* find observe registration for resource */
+#ifdef MODULE_GCOAP_OBS_MULTI
+    /* ... by this observer, other observers don't get in the way */
+    if (observer != NULL) {
+        _find_obs_memo_resource(&resource_memo, resource, observer);
+    }
+#else
+    _find_obs_memo_resource(&resource_memo, resource, NULL);
+#endif
+
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         /* lookup remote+token */
-        int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, observer, pdu);
         /* validate re-registration request */
         if (resource_memo != NULL) {
             if (memo != NULL) {
@@ -298,7 +475,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 }
                 /* otherwise OK to re-register resource with the same token */
             }
-            else if (sock_udp_ep_equal(remote, resource_memo->observer)) {
+            else if ((observer != NULL) &&
+                     (observer == resource_memo->observer)) {
                 /* accept new token for resource */
                 memo = resource_memo;
             }
@@ -306,20 +484,23 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* initialize new registration request */
         if ((memo == NULL) && coap_has_observe(pdu)) {
             /* verify resource not already registerered (for another endpoint) */
-            if ((empty_slot >= 0) && (resource_memo == NULL)) {
-                int obs_slot = _find_observer(&observer, remote);
+            if ((_coap_state.obs_memo_pool_numof > 0) &&
+                (resource_memo == NULL)) {
                 /* cache new observer */
                 if (observer == NULL) {
-                    if (obs_slot >= 0) {
-                        observer = &_coap_state.observers[obs_slot];
-                        memcpy(observer, remote, sizeof(sock_udp_ep_t));
-                    } else {
+                    observer = _add_observer(remote);
+                    if (observer == NULL) {
                         DEBUG("gcoap: can't register observer\n");
                     }
                 }
                 if (observer != NULL) {
-                    memo = &_coap_state.observe_memos[empty_slot];
+                    int idx = _pool_get(_coap_state.obs_memo_pool,
+                                        &_coap_state.obs_memo_pool_numof);
+
+                    memo = &_coap_state.observe_memos[idx];
                     memo->observer = observer;
+                    _coap_state.observer_refs[observer -
+                                              _coap_state.observers]++;
                 }
             }
             if (memo == NULL) {
@@ -329,12 +510,15 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* finish registration */
         if (memo != NULL) {
+            /* resource and token are the keys of the memo's hash chains */
+            _unlink_obs_memo(memo);
             /* resource may be assigned here if it is not already registered */
             memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+            _link_obs_memo(memo);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
             /* generate initial notification value */
             uint32_t now       = xtimer_now_usec();
@@ -342,27 +526,21 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
 
     } else if (coap_get_observe(pdu) == COAP_OBS_DEREGISTER) {
-        _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, observer, pdu);
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
-            if (memo == NULL) {
-                _find_observer(&observer, remote);
-                if (observer != NULL) {
-                    observer->family = AF_UNSPEC;
-                }
-            }
+            _free_obs_memo(memo);
         }
         coap_clear_observe(pdu);
 
     } else if (coap_has_observe(pdu)) {
+        mutex_unlock(&_coap_state.lock);
         /* bogus request; don't respond */
         DEBUG("gcoap: Observe value unexpected: %" PRIu32 "\n", coap_get_observe(pdu));
         return -1;
     }
+    mutex_unlock(&_coap_state.lock);
 
     ssize_t pdu_len = resource->handler(pdu, buf, len, resource->context);
     if (pdu_len < 0) {
@@ -374,6 +552,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
+ * Listeners are searched in order of registration.
  *
  * param[out] resource_ptr -- found resource
  * param[out] listener_ptr -- listener for found resource
@@ -391,30 +570,18 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
-
-                *resource_ptr = resource;
+        switch (coap_find_resource(listener->resources,
+                                   listener->resources_len,
+                                   (char *)&pdu->url[0], method_flag,
+                                   resource_ptr)) {
+            case 0:
                 *listener_ptr = listener;
                 return GCOAP_RESOURCE_FOUND;
-            }
+            case -ENOTSUP:
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                break;
+            default:
+                break;
         }
         listener = listener->next;
     }
@@ -462,18 +629,12 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
-
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = *_req_bucket(src_pdu->token, cmplen); i != 0;
+         i = _coap_state.req_next[i - 1]) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i - 1];
 
+        memo_pdu->hdr = _req_memo_hdr(memo);
         if (coap_get_token_len(memo_pdu) == cmplen) {
             memo_pdu->token = &memo_pdu->hdr->data[0];
             if ((memcmp(src_pdu->token, memo_pdu->token, cmplen) == 0)
@@ -483,29 +644,48 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
             }
         }
     }
+    mutex_unlock(&_coap_state.lock);
 }
 
-/* Calls handler callback on receipt of a timeout message. */
+/*
+ * Returns a request memo and its resend buffer, if any, to their pools.
+ *
+ * Caller must hold _coap_state.lock.
+ */
+static void _free_req_memo(gcoap_request_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.open_reqs;
+    coap_pkt_t memo_pdu;
+
+    memo_pdu.hdr = _req_memo_hdr(memo);
+    _chain_remove(_req_bucket(&memo_pdu.hdr->data[0],
+                              coap_get_token_len(&memo_pdu)),
+                  _coap_state.req_next, idx);
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        _pool_put(_coap_state.resend_buf_pool,
+                  &_coap_state.resend_buf_pool_numof,
+                  (memo->msg.data.pdu_buf - &_coap_state.resend_bufs[0][0]) /
+                  GCOAP_PDU_BUF_SIZE);
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+    _pool_put(_coap_state.req_pool, &_coap_state.req_pool_numof, idx);
+}
+
+/* Calls handler callback on expiry of a response timer. */
 static void _expire_request(gcoap_request_memo_t *memo)
 {
-    DEBUG("coap: received timeout message\n");
+    DEBUG("coap: response timed out\n");
     if (memo->state == GCOAP_MEMO_WAIT) {
         memo->state = GCOAP_MEMO_TIMEOUT;
         /* Pass response to handler */
         if (memo->resp_handler) {
             coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
+            req.hdr = _req_memo_hdr(memo);      /* for reference */
             memo->resp_handler(memo->state, &req, NULL);
         }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        mutex_lock(&_coap_state.lock);
+        _free_req_memo(memo);
+        mutex_unlock(&_coap_state.lock);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -594,93 +774,144 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 /*
  * Find registered observer for a remote address and port.
  *
+ * Caller must hold _coap_state.lock.
+ *
  * observer[out] -- Registered observer, or NULL if not found
  * remote[in] -- Endpoint to match
- *
- * return Index of empty slot, suitable for registering new observer; or -1
- *        if no empty slots. Undefined if observer found.
  */
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
+static void _find_observer(sock_udp_ep_t **observer, const sock_udp_ep_t *remote)
 {
-    int empty_slot = -1;
-    *observer      = NULL;
-    for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
-
-        if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
-        }
-        else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
+    *observer = NULL;
+    for (unsigned i = *_observer_bucket(remote); i != 0;
+         i = _coap_state.observer_next[i - 1]) {
+        if (sock_udp_ep_equal(&_coap_state.observers[i - 1], remote)) {
+            *observer = &_coap_state.observers[i - 1];
             break;
         }
     }
-    return empty_slot;
 }
 
 /*
- * Find registered observe memo for a remote address and token.
+ * Registers a new observer without any observe memos.
  *
- * memo[out] -- Registered observe memo, or NULL if not found
- * remote[in] -- Endpoint for address to match
- * pdu[in] -- PDU for token to match, or NULL to match only on remote address
+ * Caller must hold _coap_state.lock.
  *
- * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ * return The new observer, or NULL if there is no space left
  */
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu)
+static sock_udp_ep_t *_add_observer(const sock_udp_ep_t *remote)
 {
-    int empty_slot = -1;
-    *memo          = NULL;
+    int idx = _pool_get(_coap_state.observer_pool,
+                        &_coap_state.observer_pool_numof);
 
-    sock_udp_ep_t *remote_observer = NULL;
-    _find_observer(&remote_observer, remote);
+    if (idx < 0) {
+        return NULL;
+    }
+    memcpy(&_coap_state.observers[idx], remote, sizeof(sock_udp_ep_t));
+    _coap_state.observer_refs[idx] = 0;
+    _chain_add(_observer_bucket(remote), _coap_state.observer_next, idx);
+    return &_coap_state.observers[idx];
+}
 
-    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
-            continue;
-        }
+/*
+ * Find registered observe memo for an observer and token.
+ *
+ * Caller must hold _coap_state.lock.
+ *
+ * memo[out] -- Registered observe memo, or NULL if not found
+ * observer[in] -- Registered observer to match; may be NULL
+ * pdu[in] -- PDU for token to match
+ */
+static void _find_obs_memo(gcoap_observe_memo_t **memo,
+                           const sock_udp_ep_t *observer, coap_pkt_t *pdu)
+{
+    unsigned cmplen = coap_get_token_len(pdu);
 
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
-            if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
-                break;
-            }
+    *memo = NULL;
+    if ((observer == NULL) || (cmplen == 0)) {
+        return;
+    }
+    for (unsigned i = *_obs_token_bucket(pdu->token, cmplen); i != 0;
+         i = _coap_state.obs_token_next[i - 1]) {
+        gcoap_observe_memo_t *entry = &_coap_state.observe_memos[i - 1];
 
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
-                if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
-                    *memo = &_coap_state.observe_memos[i];
-                    break;
-                }
-            }
+        if ((entry->observer == observer) && (entry->token_len == cmplen) &&
+            (memcmp(&entry->token[0], &pdu->token[0], cmplen) == 0)) {
+            *memo = entry;
+            break;
         }
     }
-    return empty_slot;
 }
 
 /*
  * Find registered observe memo for a resource.
  *
+ * Caller must hold _coap_state.lock.
+ *
  * memo[out] -- Registered observe memo, or NULL if not found
  * resource[in] -- Resource to match
+ * observer[in] -- Registered observer to match; matches any if NULL
  */
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource)
+                                   const coap_resource_t *resource,
+                                   const sock_udp_ep_t *observer)
 {
     *memo = NULL;
-    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
+    for (unsigned i = *_obs_resource_bucket(resource); i != 0;
+         i = _coap_state.obs_resource_next[i - 1]) {
+        if ((_coap_state.observe_memos[i - 1].resource == resource) &&
+            ((observer == NULL) ||
+             (_coap_state.observe_memos[i - 1].observer == observer))) {
+            *memo = &_coap_state.observe_memos[i - 1];
             break;
         }
     }
 }
 
+/* Adds an observe memo to the hash chains for its resource and token. */
+static void _link_obs_memo(gcoap_observe_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
+
+    _chain_add(_obs_resource_bucket(memo->resource),
+               _coap_state.obs_resource_next, idx);
+    _chain_add(_obs_token_bucket(memo->token, memo->token_len),
+               _coap_state.obs_token_next, idx);
+}
+
+/* Removes an observe memo from the hash chains, if it is in there. */
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
+
+    _chain_remove(_obs_resource_bucket(memo->resource),
+                  _coap_state.obs_resource_next, idx);
+    _chain_remove(_obs_token_bucket(memo->token, memo->token_len),
+                  _coap_state.obs_token_next, idx);
+}
+
+/*
+ * Returns an observe memo to its pool, and its observer as well if the
+ * observer has no other memos.
+ *
+ * Caller must hold _coap_state.lock.
+ */
+static void _free_obs_memo(gcoap_observe_memo_t *memo)
+{
+    unsigned obs_idx = memo->observer - _coap_state.observers;
+
+    _unlink_obs_memo(memo);
+    if (--_coap_state.observer_refs[obs_idx] == 0) {
+        _chain_remove(_observer_bucket(memo->observer),
+                      _coap_state.observer_next, obs_idx);
+        memo->observer->family = AF_UNSPEC;
+        _pool_put(_coap_state.observer_pool, &_coap_state.observer_pool_numof,
+                  obs_idx);
+    }
+    memo->observer = NULL;
+    _pool_put(_coap_state.obs_memo_pool, &_coap_state.obs_memo_pool_numof,
+              memo - _coap_state.observe_memos);
+}
+
 /*
  * gcoap interface functions
  */
@@ -699,6 +930,21 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    memset(_coap_state.req_buckets, 0, sizeof(_coap_state.req_buckets));
+    memset(_coap_state.observer_buckets, 0,
+           sizeof(_coap_state.observer_buckets));
+    memset(_coap_state.obs_token_buckets, 0,
+           sizeof(_coap_state.obs_token_buckets));
+    memset(_coap_state.obs_resource_buckets, 0,
+           sizeof(_coap_state.obs_resource_buckets));
+    _pool_init(_coap_state.req_pool, &_coap_state.req_pool_numof,
+               GCOAP_REQ_WAITING_MAX);
+    _pool_init(_coap_state.resend_buf_pool, &_coap_state.resend_buf_pool_numof,
+               GCOAP_RESEND_BUFS_MAX);
+    _pool_init(_coap_state.observer_pool, &_coap_state.observer_pool_numof,
+               GCOAP_OBS_CLIENTS_MAX);
+    _pool_init(_coap_state.obs_memo_pool, &_coap_state.obs_memo_pool_numof,
+               GCOAP_OBS_REGISTRATIONS_MAX);
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -802,19 +1048,17 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
         mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
-                break;
-            }
-        }
-        if (!memo) {
+        /* Take an empty slot from the pool of open requests. */
+        int idx = _pool_get(_coap_state.req_pool, &_coap_state.req_pool_numof);
+        if (idx < 0) {
             mutex_unlock(&_coap_state.lock);
             DEBUG("gcoap: dropping request; no space for response tracking\n");
             return 0;
         }
+        memo = &_coap_state.open_reqs[idx];
+        memo->state = GCOAP_MEMO_WAIT;
+        /* until a resend buffer is assigned */
+        memo->send_limit = GCOAP_SEND_LIMIT_NON;
 
         memo->resp_handler = resp_handler;
         memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
@@ -822,16 +1066,12 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
         switch (msg_type) {
         case COAP_TYPE_CON:
             /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
-            }
-            if (memo->msg.data.pdu_buf) {
+            idx = _pool_get(_coap_state.resend_buf_pool,
+                            &_coap_state.resend_buf_pool_numof);
+            if (idx >= 0) {
+                memo->msg.data.pdu_buf = &_coap_state.resend_bufs[idx][0];
+                memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
+                memo->msg.data.pdu_len = len;
                 memo->send_limit  = COAP_MAX_RETRANSMIT;
                 timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
                 uint32_t variance = (uint32_t)COAP_ACK_VARIANCE * US_PER_SEC;
@@ -844,7 +1084,6 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
             break;
 
         case COAP_TYPE_NON:
-            memo->send_limit = GCOAP_SEND_LIMIT_NON;
             memcpy(&memo->msg.hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
             timeout = GCOAP_NON_TIMEOUT;
             break;
@@ -853,45 +1092,40 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
-        mutex_unlock(&_coap_state.lock);
         if (memo->state == GCOAP_MEMO_UNUSED) {
+            _pool_put(_coap_state.req_pool, &_coap_state.req_pool_numof,
+                      memo - _coap_state.open_reqs);
+            mutex_unlock(&_coap_state.lock);
             return 0;
         }
+        /* index the memo by the request's token */
+        coap_hdr_t *hdr = _req_memo_hdr(memo);
+        _chain_add(_req_bucket(&hdr->data[0], hdr->ver_t_tkl & 0xf),
+                   _coap_state.req_next, memo - _coap_state.open_reqs);
+        mutex_unlock(&_coap_state.lock);
     }
 
-    /* Memos complete; send msg and start timer */
-    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
-
-    /* timeout may be zero for non-confirmable */
-    if ((memo != NULL) && (res > 0) && (timeout > 0)) {
-        /* We assume gcoap_req_send2() is called on some thread other than
-         * gcoap's. First, put a message in the mbox for the sock udp object,
-         * which will interrupt listening on the gcoap thread. (When there are
-         * no outstanding requests, gcoap blocks indefinitely in _listen() at
-         * sock_udp_recv().) While the message sent here is outstanding, the
-         * sock_udp_recv() call will be set to a short timeout so the request
-         * timer below, also on the gcoap thread, is processed in a timely
-         * manner. */
-        msg_t mbox_msg;
-        mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
-        mbox_msg.content.value = 0;
-        if (mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
-            /* start response wait timer on the gcoap thread */
-            memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
-            memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
-        }
-        else {
-            res = 0;
-            DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
+    /* Memos complete; start timer and send msg. The timer is started first,
+     * so a response handled on the gcoap thread always finds it set. */
+    if (memo != NULL) {
+        /* the timeout event is handled on the gcoap thread, regardless of the
+         * thread gcoap_req_send2() is called on. It is initialized even if
+         * it is not set (timeout may be zero for non-confirmable), as a
+         * response clears and cancels it either way */
+        event_callback_init(&memo->resp_evt, _on_resp_timeout, memo);
+        event_timeout_init(&memo->resp_tmout, &_queue, &memo->resp_evt.super);
+        if (timeout > 0) {
+            event_timeout_set(&memo->resp_tmout, timeout);
         }
     }
+    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
+
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
-            memo->state = GCOAP_MEMO_UNUSED;
+            event_timeout_clear(&memo->resp_tmout);
+            mutex_lock(&_coap_state.lock);
+            _free_req_memo(memo);
+            mutex_unlock(&_coap_state.lock);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
@@ -920,8 +1154,10 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     gcoap_observe_memo_t *memo = NULL;
 
-    _find_obs_memo_resource(&memo, resource);
+    mutex_lock(&_coap_state.lock);
+    _find_obs_memo_resource(&memo, resource, NULL);
     if (memo == NULL) {
+        mutex_unlock(&_coap_state.lock);
         /* Unique return value to specify there is not an observer */
         return GCOAP_OBS_INIT_UNUSED;
     }
@@ -930,6 +1166,7 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
     ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &memo->token[0],
                                     memo->token_len, COAP_CODE_CONTENT, msgid);
+    mutex_unlock(&_coap_state.lock);
 
     if (hdrlen > 0) {
         uint32_t now       = xtimer_now_usec();
@@ -954,11 +1191,18 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
     gcoap_observe_memo_t *memo = NULL;
+    sock_udp_ep_t observer;
 
-    _find_obs_memo_resource(&memo, resource);
+    mutex_lock(&_coap_state.lock);
+    _find_obs_memo_resource(&memo, resource, NULL);
+    if (memo) {
+        /* the registration may go away while sending */
+        memcpy(&observer, memo->observer, sizeof(observer));
+    }
+    mutex_unlock(&_coap_state.lock);
 
     if (memo) {
-        ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
+        ssize_t bytes = sock_udp_send(&_sock, buf, len, &observer);
         return (size_t)((bytes > 0) ? bytes : 0);
     }
     else {
@@ -966,17 +1210,96 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
     }
 }
 
-uint8_t gcoap_op_state(void)
+int gcoap_obs_notify_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          const coap_resource_t *resource)
+{
+    gcoap_observe_memo_t *memo = NULL;
+    uint8_t token[GCOAP_TOKENLEN_MAX] = { 0 };
+
+    mutex_lock(&_coap_state.lock);
+    _find_obs_memo_resource(&memo, resource, NULL);
+    mutex_unlock(&_coap_state.lock);
+    if (memo == NULL) {
+        return GCOAP_OBS_INIT_UNUSED;
+    }
+    if (len < GCOAP_HEADER_MAXLEN + GCOAP_OBS_OPTIONS_BUF) {
+        return GCOAP_OBS_INIT_ERR;
+    }
+
+    /* leave room for the longest token, gcoap_obs_notify_all() writes the
+     * header of each notification right in front of the options */
+    pdu->hdr = (coap_hdr_t *)buf;
+    coap_build_hdr(pdu->hdr, COAP_TYPE_NON, token, sizeof(token),
+                   COAP_CODE_CONTENT, 0);
+
+    uint32_t now       = xtimer_now_usec();
+    pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
+    pdu->payload       = buf + GCOAP_HEADER_MAXLEN + GCOAP_OBS_OPTIONS_BUF;
+    pdu->payload_len   = len - (pdu->payload - buf);
+    pdu->content_type  = COAP_FORMAT_NONE;
+
+    return GCOAP_OBS_INIT_OK;
+}
+
+size_t gcoap_obs_notify_all(uint8_t *buf, size_t len,
+                            const coap_resource_t *resource)
 {
-    uint8_t count = 0;
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
+    uint16_t memos[GCOAP_OBS_REGISTRATIONS_MAX];
+    unsigned numof = 0;
+    size_t count = 0;
+
+    if (len <= GCOAP_HEADER_MAXLEN) {
+        return 0;
+    }
+
+    /* the gcoap thread needs the lock to handle requests, so never keep it
+     * while sending */
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = *_obs_resource_bucket(resource); i != 0;
+         i = _coap_state.obs_resource_next[i - 1]) {
+        if (_coap_state.observe_memos[i - 1].resource == resource) {
+            memos[numof++] = i - 1;
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    for (unsigned i = 0; i < numof; i++) {
+        gcoap_observe_memo_t *memo = &_coap_state.observe_memos[memos[i]];
+        uint8_t token[GCOAP_TOKENLEN_MAX];
+        sock_udp_ep_t observer;
+        unsigned token_len;
+        uint16_t msgid;
+
+        mutex_lock(&_coap_state.lock);
+        /* the registration may have gone away in the meantime */
+        if ((memo->observer == NULL) || (memo->resource != resource)) {
+            mutex_unlock(&_coap_state.lock);
+            continue;
+        }
+        memcpy(&observer, memo->observer, sizeof(observer));
+        token_len = memo->token_len;
+        memcpy(token, memo->token, token_len);
+        msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+        mutex_unlock(&_coap_state.lock);
+
+        /* only the header differs between observers */
+        unsigned offset = GCOAP_TOKENLEN_MAX - token_len;
+        coap_build_hdr((coap_hdr_t *)(buf + offset), COAP_TYPE_NON, token,
+                       token_len, COAP_CODE_CONTENT, msgid);
+        if (sock_udp_send(&_sock, buf + offset, len - offset,
+                          &observer) > 0) {
             count++;
         }
     }
+
     return count;
 }
 
+unsigned gcoap_op_state(void)
+{
+    return GCOAP_REQ_WAITING_MAX - _coap_state.req_pool_numof;
+}
+
 int gcoap_get_resource_list(void *buf, size_t maxlen, uint8_t cf)
 {
     (void)cf; /* only used in the assert below. */
@@ -287,6 +287,71 @@ int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsign
     return (blkopt & 0x8) ? 1 : 0;
 }
 
+/* compares a resource path with the first len characters of uri, like
+ * strcmp() would with uri cut after them */
+static int _path_cmp(const char *path, const char *uri, size_t len)
+{
+    int res = strncmp(path, uri, len);
+
+    if (res != 0) {
+        return res;
+    }
+    return (path[len] != '\0');
+}
+
+/* finds the first resource with a path of at least uri cut after len
+ * characters */
+static size_t _lower_bound(const coap_resource_t *resources, size_t numof,
+                           const char *uri, size_t len)
+{
+    size_t lo = 0, hi = numof;
+
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) / 2);
+
+        if (_path_cmp(resources[mid].path, uri, len) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const char *uri, unsigned method_flag,
+                       const coap_resource_t **resource)
+{
+    size_t uri_len = strlen(uri);
+    size_t len = uri_len;
+    int ret = -ENOENT;
+
+    /* first the exact path, then the subtrees it is in, longest first */
+    while (len > 0) {
+        for (size_t i = _lower_bound(resources, resources_numof, uri, len);
+             (i < resources_numof) &&
+             (_path_cmp(resources[i].path, uri, len) == 0); i++) {
+            if ((len < uri_len) &&
+                !(resources[i].methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (!(resources[i].methods & method_flag)) {
+                ret = -ENOTSUP;
+                continue;
+            }
+            *resource = &resources[i];
+            return 0;
+        }
+        /* cut off the last path segment, down to the root path "/" */
+        do {
+            len--;
+        } while ((len > 1) && (uri[len] != '/'));
+    }
+
+    return ret;
+}
+
 ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_len)
 {
     if (coap_get_code_class(pkt) != COAP_REQ) {
@@ -310,25 +375,20 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
 #endif
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < coap_resources_numof; i++) {
-        const coap_resource_t *resource = &coap_resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
+    const coap_resource_t *resource;
 
-        int res = strcmp((char *)uri, resource->path);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+    switch (coap_find_resource(coap_resources, coap_resources_numof,
+                               (char *)uri, method_flag, &resource)) {
+        case 0:
+            return resource->handler(pkt, resp_buf, resp_buf_len,
+                                     resource->context);
+        case -ENOTSUP:
+            return coap_build_reply(pkt, COAP_CODE_METHOD_NOT_ALLOWED,
+                                    resp_buf, resp_buf_len, 0);
+        default:
+            return coap_build_reply(pkt, COAP_CODE_404, resp_buf,
+                                    resp_buf_len, 0);
     }
-
-    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
 }
 
 ssize_t coap_reply_simple(coap_pkt_t *pkt,
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -118,6 +119,19 @@ ssize_t nanocoap_get(sock_udp_ep_t *remote, const char *path, uint8_t *buf, size
     return res;
 }
 
+/* releases a buffer of sock_udp_recv_buf(), returns false if the message
+ * was split over several chunks */
+static bool _recv_buf_release(sock_udp_t *sock, void **buf_ctx)
+{
+    bool single = true;
+    void *data;
+
+    while (sock_udp_recv_buf(sock, &data, buf_ctx, 0, NULL) > 0) {
+        single = false;
+    }
+    return single;
+}
+
 int nanocoap_server(sock_udp_ep_t *local, uint8_t *buf, size_t bufsize)
 {
     sock_udp_t sock;
@@ -133,20 +147,33 @@ int nanocoap_server(sock_udp_ep_t *local, uint8_t *buf, size_t bufsize)
     }
 
     while (1) {
-        res = sock_udp_recv(&sock, buf, bufsize, -1, &remote);
-        if (res == -1) {
+        coap_pkt_t pkt;
+        void *data, *buf_ctx = NULL;
+
+        /* parse the request where the stack received it, only the response
+         * is written to buf */
+        res = sock_udp_recv_buf(&sock, &data, &buf_ctx, SOCK_NO_TIMEOUT,
+                                &remote);
+        if (res < 0) {
             DEBUG("error receiving UDP packet\n");
             return -1;
         }
+        else if (res == 0) {
+            continue;
+        }
+        if (coap_parse(&pkt, data, res) < 0) {
+            DEBUG("error parsing packet\n");
+            res = 0;
+        }
         else {
-            coap_pkt_t pkt;
-            if (coap_parse(&pkt, (uint8_t *)buf, res) < 0) {
-                DEBUG("error parsing packet\n");
-                continue;
-            }
-            if ((res = coap_handle_req(&pkt, buf, bufsize)) > 0) {
-                res = sock_udp_send(&sock, buf, res, &remote);
-            }
+            res = coap_handle_req(&pkt, buf, bufsize);
+        }
+        if (!_recv_buf_release(&sock, &buf_ctx)) {
+            DEBUG("request does not fit into a single chunk\n");
+            continue;
+        }
+        if (res > 0) {
+            res = sock_udp_send(&sock, buf, res, &remote);
         }
     }
 
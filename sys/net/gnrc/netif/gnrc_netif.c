@@ -26,6 +26,9 @@
 #ifdef MODULE_NETSTATS_IPV6
 #include "net/netstats.h"
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
 #include "log.h"
 #include "sched.h"
 
@@ -1193,6 +1196,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     if (res > 0) {
         netif->l2addr_len = res;
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    /* cached compression decisions depend on the link-layer address */
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
 }
 
 static void _init_from_device(gnrc_netif_t *netif)
@@ -28,17 +28,42 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of two"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hashed demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* demux contexts are mostly 16-bit ports and protocol numbers, but
+     * GNRC_NETREG_DEMUX_CTX_ALL only uses the upper half */
+    return &netreg[type][(demux_ctx ^ (demux_ctx >> 16)) &
+                         (GNRC_NETREG_HASH_BUCKETS - 1)];
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
+    gnrc_netreg_entry_t **list, *ptr;
+
 #ifdef DEVELHELP
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
     bool has_msg_q = (entry->type != GNRC_NETREG_TYPE_DEFAULT) ||
@@ -59,7 +84,17 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    /* keep entries with the same demux context next to each other, so
+     * gnrc_netreg_getnext() and gnrc_netreg_num() only need to look at the
+     * entries following the first one */
+    list = _list(type, entry->demux_ctx);
+    LL_SEARCH_SCALAR(*list, ptr, demux_ctx, entry->demux_ctx);
+    if (ptr == NULL) {
+        LL_PREPEND(*list, entry);
+    }
+    else {
+        LL_PREPEND_ELEM(*list, ptr, entry);
+    }
 
     return 0;
 }
@@ -70,54 +105,46 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_list(type, entry->demux_ctx), entry);
 }
 
-/**
- * @brief   Searches the next entry in the registry that matches given
- *          parameters, start lookup from beginning or given entry.
- *
- * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
- * @param[in] demux_ctx The demultiplexing context for the registered thread.
- *                      See gnrc_netreg_entry_t::demux_ctx.
- *
- * @return  The first entry fitting the given parameters on success
- * @return  NULL if no entry can be found.
- */
-static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
-                                           gnrc_nettype_t type,
-                                           uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     gnrc_netreg_entry_t *res = NULL;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (!_INVALID_TYPE(type)) {
+        LL_SEARCH_SCALAR(*_list(type, demux_ctx), res, demux_ctx, demux_ctx);
     }
 
     return res;
 }
 
-gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
+int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    return _netreg_lookup(NULL, type, demux_ctx);
+    int num;
+
+    gnrc_netreg_lookup_num(type, demux_ctx, &num);
+    return num;
 }
 
-int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num)
 {
-    int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
+    gnrc_netreg_entry_t *res = gnrc_netreg_lookup(type, demux_ctx);
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
-        num++;
+    *num = 0;
+    for (gnrc_netreg_entry_t *entry = res; entry != NULL;
+         entry = gnrc_netreg_getnext(entry)) {
+        (*num)++;
     }
-    return num;
+    return res;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+    /* entries with the same demux context are kept next to each other */
+    return ((entry != NULL) && (entry->next != NULL) &&
+            (entry->next->demux_ctx == entry->demux_ctx)) ? entry->next : NULL;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -247,7 +247,7 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
 
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    msg_t msgs[GNRC_IPV6_MSG_BULK_SIZE], reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -263,47 +263,52 @@ static void *_event_loop(void *args)
     /* start event loop */
     while (1) {
         DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
-
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr, true);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_GET:
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                DEBUG("ipv6: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            case GNRC_IPV6_NIB_SND_UC_NS:
-            case GNRC_IPV6_NIB_SND_MC_NS:
-            case GNRC_IPV6_NIB_SND_NA:
-            case GNRC_IPV6_NIB_SEARCH_RTR:
-            case GNRC_IPV6_NIB_REPLY_RS:
-            case GNRC_IPV6_NIB_SND_MC_RA:
-            case GNRC_IPV6_NIB_REACH_TIMEOUT:
-            case GNRC_IPV6_NIB_DELAY_TIMEOUT:
-            case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
-            case GNRC_IPV6_NIB_ABR_TIMEOUT:
-            case GNRC_IPV6_NIB_PFX_TIMEOUT:
-            case GNRC_IPV6_NIB_RTR_TIMEOUT:
-            case GNRC_IPV6_NIB_RECALC_REACH_TIME:
-            case GNRC_IPV6_NIB_REREG_ADDRESS:
-            case GNRC_IPV6_NIB_DAD:
-            case GNRC_IPV6_NIB_VALID_ADDR:
-                DEBUG("ipv6: NIB timer event received\n");
-                gnrc_ipv6_nib_handle_timer_event(msg.content.ptr, msg.type);
-                break;
-            default:
-                break;
+        /* drain bursts of messages with a single wakeup */
+        int num = msg_receive_bulk(msgs, GNRC_IPV6_MSG_BULK_SIZE);
+
+        for (int i = 0; i < num; i++) {
+            msg_t *msg = &msgs[i];
+
+            switch (msg->type) {
+                case GNRC_NETAPI_MSG_TYPE_RCV:
+                    DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+                    _receive(msg->content.ptr);
+                    break;
+
+                case GNRC_NETAPI_MSG_TYPE_SND:
+                    DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                    _send(msg->content.ptr, true);
+                    break;
+
+                case GNRC_NETAPI_MSG_TYPE_GET:
+                case GNRC_NETAPI_MSG_TYPE_SET:
+                    DEBUG("ipv6: reply to unsupported get/set\n");
+                    reply.content.value = -ENOTSUP;
+                    msg_reply(msg, &reply);
+                    break;
+
+                case GNRC_IPV6_NIB_SND_UC_NS:
+                case GNRC_IPV6_NIB_SND_MC_NS:
+                case GNRC_IPV6_NIB_SND_NA:
+                case GNRC_IPV6_NIB_SEARCH_RTR:
+                case GNRC_IPV6_NIB_REPLY_RS:
+                case GNRC_IPV6_NIB_SND_MC_RA:
+                case GNRC_IPV6_NIB_REACH_TIMEOUT:
+                case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+                case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
+                case GNRC_IPV6_NIB_ABR_TIMEOUT:
+                case GNRC_IPV6_NIB_PFX_TIMEOUT:
+                case GNRC_IPV6_NIB_RTR_TIMEOUT:
+                case GNRC_IPV6_NIB_RECALC_REACH_TIME:
+                case GNRC_IPV6_NIB_REREG_ADDRESS:
+                case GNRC_IPV6_NIB_DAD:
+                case GNRC_IPV6_NIB_VALID_ADDR:
+                    DEBUG("ipv6: NIB timer event received\n");
+                    gnrc_ipv6_nib_handle_timer_event(msg->content.ptr, msg->type);
+                    break;
+                default:
+                    break;
+            }
         }
     }
 
@@ -533,28 +538,32 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
         gnrc_pktbuf_hold(pkt, ifnum - 1);
 
         while ((netif = gnrc_netif_iter(netif))) {
+            gnrc_pktsnip_t *tmp = pkt;
+
             if (prep_hdr) {
                 DEBUG("ipv6: prepare IPv6 header for sending\n");
                 /* need to get second write access (duplication) to fill IPv6
-                 * header interface-local */
-                gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
+                 * header interface-local. Only the headers up to the payload
+                 * header are duplicated, the payload stays shared between all
+                 * interfaces (copy-on-write by gnrc_pktbuf_start_write()).
+                 * For the last interface no duplication is needed at all */
+                tmp = gnrc_pktbuf_start_write(pkt);
 
                 if (tmp == NULL) {
                     DEBUG("ipv6: unable to get write access to IPv6 header, "
                           "for interface %" PRIkernel_pid "\n", netif->pid);
+                    /* drop the hold of this interface only */
                     gnrc_pktbuf_release(pkt);
-                    return;
+                    continue;
                 }
                 if (_fill_ipv6_hdr(netif, tmp) < 0) {
-                    /* error on filling up header */
-                    if (tmp != pkt) {
-                        gnrc_pktbuf_release(tmp);
-                    }
-                    gnrc_pktbuf_release(pkt);
-                    return;
+                    /* error on filling up header: releasing tmp also drops
+                     * the hold of this interface on the shared snips */
+                    gnrc_pktbuf_release(tmp);
+                    continue;
                 }
             }
-            _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
+            _send_multicast_over_iface(tmp, netif, netif_hdr_flags);
         }
     }
     else {
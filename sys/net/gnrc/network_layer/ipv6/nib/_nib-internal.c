@@ -36,6 +36,11 @@ static clist_node_t _next_removable = { NULL };
 
 static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
+/* allocated off-link entries sorted by descending prefix length (and by
+ * position in _dsts within the same prefix length), so the first matching
+ * entry is the longest prefix match */
+static _nib_offl_entry_t *_dsts_lpm[GNRC_IPV6_NIB_OFFL_NUMOF];
+static unsigned _dsts_lpm_numof;
 static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
@@ -59,6 +64,7 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+    _dsts_lpm_numof = 0;
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
@@ -437,6 +443,48 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+static void _lpm_add(_nib_offl_entry_t *dst)
+{
+    unsigned pos = 0;
+
+    assert(_dsts_lpm_numof < GNRC_IPV6_NIB_OFFL_NUMOF);
+    while ((pos < _dsts_lpm_numof) &&
+           ((_dsts_lpm[pos]->pfx_len > dst->pfx_len) ||
+            ((_dsts_lpm[pos]->pfx_len == dst->pfx_len) &&
+             (_dsts_lpm[pos] < dst)))) {
+        pos++;
+    }
+    memmove(&_dsts_lpm[pos + 1], &_dsts_lpm[pos],
+            (_dsts_lpm_numof - pos) * sizeof(_dsts_lpm[0]));
+    _dsts_lpm[pos] = dst;
+    _dsts_lpm_numof++;
+}
+
+static void _lpm_remove(const _nib_offl_entry_t *dst)
+{
+    for (unsigned pos = 0; pos < _dsts_lpm_numof; pos++) {
+        if (_dsts_lpm[pos] == dst) {
+            _dsts_lpm_numof--;
+            memmove(&_dsts_lpm[pos], &_dsts_lpm[pos + 1],
+                    (_dsts_lpm_numof - pos) * sizeof(_dsts_lpm[0]));
+            return;
+        }
+    }
+}
+
+/* checks if the first pfx_len bits of addr are equal to pfx */
+static inline bool _pfx_matches(const ipv6_addr_t *pfx, const ipv6_addr_t *addr,
+                                unsigned pfx_len)
+{
+    unsigned bytes = pfx_len / 8, bits = pfx_len % 8;
+
+    if (memcmp(pfx, addr, bytes) != 0) {
+        return false;
+    }
+    return (bits == 0) ||
+           (((pfx->u8[bytes] ^ addr->u8[bytes]) & (0xff00 >> bits)) == 0);
+}
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -484,6 +532,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _lpm_add(dst);
     }
     return dst;
 }
@@ -515,6 +564,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _lpm_remove(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -540,31 +590,26 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
-    _nib_offl_entry_t *res = NULL;
-    uint8_t best_match = 0;
-
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
-    for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
-        if (entry->mode != _EMPTY) {
-            uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
+    /* _dsts_lpm is sorted by prefix length, so the first match is the best */
+    for (unsigned i = 0; i < _dsts_lpm_numof; i++) {
+        _nib_offl_entry_t *entry = _dsts_lpm[i];
 
-            DEBUG("nib: %s/%u => ",
+        if ((entry->mode != _EMPTY) &&
+            _pfx_matches(&entry->pfx, dst, entry->pfx_len)) {
+            DEBUG("nib: best match %s/%u => ",
                   ipv6_addr_to_str(addr_str, &entry->pfx, sizeof(addr_str)),
                   entry->pfx_len);
-            DEBUG("%s%%%u matches with %u bits\n",
+            DEBUG("%s%%%u\n",
                   (entry->mode == _PL) ? "(nil)" :
                   ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
                                    sizeof(addr_str)),
-                  _nib_onl_get_if(entry->next_hop), match);
-            if ((match > best_match) && (match >= entry->pfx_len)) {
-                DEBUG("nib: best match (%u bits)\n", match);
-                res = entry;
-                best_match = match;
-            }
+                  _nib_onl_get_if(entry->next_hop));
+            return entry;
         }
     }
-    return res;
+    return NULL;
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
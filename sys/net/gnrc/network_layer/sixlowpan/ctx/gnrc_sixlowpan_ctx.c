@@ -17,6 +17,9 @@
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
 #include "xtimer.h"
 
 #define ENABLE_DEBUG    (0)
@@ -126,6 +129,10 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
     _ctx_inval_times[id] = ltime + _current_minute();
 
     mutex_unlock(&_ctx_mutex);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    /* cached compression decisions may not reflect this context */
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
     return &(_ctxs[id]);
 }
 
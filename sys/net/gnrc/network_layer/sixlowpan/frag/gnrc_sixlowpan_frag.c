@@ -27,6 +27,9 @@
 #include "utlist.h"
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -229,6 +232,11 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     return local_offset;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
 {
     return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
@@ -262,7 +270,7 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
         /* increment tag for successive, fragmented datagrams */
-        _tag++;
+        gnrc_sixlowpan_frag_next_tag();
         if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
@@ -327,12 +335,20 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (vrb_forward(hdr, pkt, offset)) {
+        return;
+    }
+#endif
     rbuf_add(hdr, pkt, offset, page);
 }
 
 void gnrc_sixlowpan_frag_rbuf_gc(void)
 {
     rbuf_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    vrb_gc();
+#endif
 }
 
 void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf)
@@ -24,27 +24,20 @@
 #include "net/sixlowpan.h"
 #include "thread.h"
 #include "xtimer.h"
-#include "utlist.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+#if (RBUF_HASH_BUCKETS & (RBUF_HASH_BUCKETS - 1)) != 0
+#error "RBUF_HASH_BUCKETS must be a power of two"
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
+static rbuf_t rbuf[RBUF_SIZE];
 
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* entries in use, hashed by their tuple */
+static rbuf_t *_buckets[RBUF_HASH_BUCKETS];
 
-static rbuf_t rbuf[RBUF_SIZE];
+static gnrc_sixlowpan_frag_rbuf_stats_t _stats;
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -54,25 +47,55 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
+/* update coverage bitmap of entry, returns number of new bytes, 0 for a
+ * duplicate or -1 if the fragment overlaps already received fragments without
+ * matching one of them exactly */
+static int _rbuf_update_received(rbuf_t *entry, uint16_t offset,
+                                 size_t frag_size);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag, unsigned page);
 
+static inline rbuf_t **_bucket(const uint8_t *src, size_t src_len,
+                               size_t size, uint16_t tag)
+{
+    /* tags are only unique per sender, so mix in the end of its address
+     * (the part that differs between neighbors) */
+    unsigned hash = tag ^ (size << 5);
+
+    if (src_len >= 2) {
+        hash ^= (src[src_len - 2] << 8) | src[src_len - 1];
+    }
+    hash ^= hash >> 8;
+    return &_buckets[hash & (RBUF_HASH_BUCKETS - 1)];
+}
+
+static rbuf_t *_rbuf_find(const uint8_t *src, size_t src_len,
+                          const uint8_t *dst, size_t dst_len,
+                          size_t size, uint16_t tag)
+{
+    rbuf_t *entry = *_bucket(src, src_len, size, tag);
+
+    while ((entry != NULL) &&
+           !((entry->datagram_size == size) && (entry->super.tag == tag) &&
+             (entry->super.src_len == src_len) &&
+             (entry->super.dst_len == dst_len) &&
+             (memcmp(entry->super.src, src, src_len) == 0) &&
+             (memcmp(entry->super.dst, dst, dst_len) == 0))) {
+        entry = entry->next;
+    }
+    return entry;
+}
+
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
               size_t offset, unsigned page)
 {
     rbuf_t *entry;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
     size_t frag_size;
+    int res;
 
     rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
@@ -82,11 +105,10 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
     if (entry == NULL) {
         DEBUG("6lo rbuf: reassembly buffer full.\n");
+        gnrc_pktbuf_release(pkt);
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         frag_size = pkt->size - sizeof(sixlowpan_frag_t);
@@ -99,34 +121,33 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         data++; /* FRAGN header is one byte longer (offset) */
     }
 
-    if ((offset + frag_size) > entry->super.pkt->size) {
+    if ((frag_size == 0) || ((offset + frag_size) > entry->super.pkt->size)) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+        _stats.discarded++;
         gnrc_pktbuf_release(entry->super.pkt);
         rbuf_rm(entry);
+        gnrc_pktbuf_release(pkt);
         return;
     }
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->super.pkt);
-            rbuf_rm(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, offset, page);
-
-            return;
-        }
+    if ((res = _rbuf_update_received(entry, offset, frag_size)) < 0) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        _stats.discarded++;
+        gnrc_pktbuf_release(entry->super.pkt);
+        rbuf_rm(entry);
 
-        ptr = ptr->next;
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, offset, page);
+
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
+    if (res > 0) {
         DEBUG("6lo rbuf: add fragment data\n");
         entry->super.current_size += (uint16_t)frag_size;
         if (offset == 0) {
@@ -137,6 +158,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                 if (frag_hdr == NULL) {
                     gnrc_pktbuf_release(entry->super.pkt);
                     rbuf_rm(entry);
+                    gnrc_pktbuf_release(pkt);
                     return;
                 }
                 gnrc_sixlowpan_iphc_recv(pkt, &entry->super, 0);
@@ -151,69 +173,86 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         memcpy(((uint8_t *)entry->super.pkt->data) + offset, data,
                frag_size);
     }
+    else {
+        DEBUG("6lo rbuf: ignore duplicate fragment\n");
+        _stats.duplicates++;
+    }
     gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(&entry->super, netif_hdr);
     gnrc_pktbuf_release(pkt);
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
-{
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
-
-static rbuf_int_t *_rbuf_int_get_free(void)
+bool rbuf_exists(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
-
-    return NULL;
+    return _rbuf_find(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                      netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, size, tag) != NULL;
 }
 
 void rbuf_rm(rbuf_t *entry)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    rbuf_t **ptr = _bucket(entry->super.src, entry->super.src_len,
+                           entry->datagram_size, entry->super.tag);
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    /* entries not in the buffer (e.g. temporary ones) are not found */
+    while ((*ptr != NULL) && (*ptr != entry)) {
+        ptr = &(*ptr)->next;
     }
-
+    if (*ptr != NULL) {
+        *ptr = entry->next;
+    }
+    entry->next = NULL;
     entry->super.pkt = NULL;
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static int _rbuf_update_received(rbuf_t *entry, uint16_t offset,
+                                 size_t frag_size)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    unsigned start = offset / 8U;
+    unsigned end = (offset + frag_size - 1) / 8U;
+    unsigned received = 0;
 
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    for (unsigned i = start; i <= end; i++) {
+        if (bf_isset(entry->received, i)) {
+            received++;
+        }
     }
+    if (received == (end - start + 1)) {
+        /* only a duplicate if an earlier fragment covered exactly the same
+         * units: it started at the same unit, no other fragment started
+         * within them and it did not go on beyond them */
+        if (!bf_isset(entry->starts, start)) {
+            return -1;
+        }
+        for (unsigned i = start + 1; i <= end; i++) {
+            if (bf_isset(entry->starts, i)) {
+                return -1;
+            }
+        }
+        if (((end + 1) < RBUF_UNITS) && bf_isset(entry->received, end + 1) &&
+            !bf_isset(entry->starts, end + 1)) {
+            return -1;
+        }
+        return 0;
+    }
+    else if (received > 0) {
+        return -1;
+    }
+    for (unsigned i = start; i <= end; i++) {
+        bf_set(entry->received, i);
+    }
+    bf_set(entry->starts, start);
 
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->super.src,
-                                                       entry->super.src_len,
-                                                       l2addr_str));
+    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %u) to entry (%s, ",
+          offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
                                                   entry->super.dst_len,
                                                   l2addr_str),
           (unsigned)entry->super.pkt->size, entry->super.tag);
 
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+    return (int)frag_size;
 }
 
 void rbuf_gc(void)
@@ -235,6 +274,7 @@ void rbuf_gc(void)
                                          l2addr_str),
                   (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
 
+            _stats.timed_out++;
             gnrc_pktbuf_release(rbuf[i].super.pkt);
             rbuf_rm(&(rbuf[i]));
         }
@@ -243,40 +283,39 @@ void rbuf_gc(void)
 
 static inline void _set_rbuf_timeout(void)
 {
-    xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
+    /* garbage collection is housekeeping, so let it coalesce with other
+     * timers */
+    xtimer_set_msg_slack(&_gc_timer, RBUF_TIMEOUT, RBUF_TIMEOUT / 4,
+                         &_gc_timer_msg, sched_active_pid);
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag, unsigned page)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res, *oldest = NULL;
+    rbuf_t **bucket;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].super.pkt != NULL) && (rbuf[i].super.pkt->size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
-            rbuf[i].arrival = now_usec;
-            _set_rbuf_timeout();
-            return &(rbuf[i]);
-        }
+    /* check first if entry already available */
+    if ((res = _rbuf_find(src, src_len, dst, dst_len, size, tag)) != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.pkt->size, res->super.tag);
+        res->arrival = now_usec;
+        _set_rbuf_timeout();
+        return res;
+    }
 
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].super.pkt == NULL)) {
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        /* if there is a free spot: take it */
+        if (rbuf[i].super.pkt == NULL) {
             res = &(rbuf[i]);
+            break;
         }
 
         /* remember oldest slot */
@@ -292,6 +331,7 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
         /* if oldest->pkt == NULL, res must not be NULL */
         assert(oldest->super.pkt != NULL);
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        _stats.evicted++;
         gnrc_pktbuf_release(oldest->super.pkt);
         rbuf_rm(oldest);
         res = oldest;
@@ -325,6 +365,12 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    res->datagram_size = size;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
+    bucket = _bucket(src, src_len, size, tag);
+    res->next = *bucket;
+    *bucket = res;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -339,4 +385,9 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+const gnrc_sixlowpan_frag_rbuf_stats_t *gnrc_sixlowpan_frag_rbuf_stats(void)
+{
+    return &_stats;
+}
+
 /** @} */
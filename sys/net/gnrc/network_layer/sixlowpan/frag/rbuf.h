@@ -20,7 +20,9 @@
 #define RBUF_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
@@ -30,26 +32,28 @@
 extern "C" {
 #endif
 
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+#endif
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
- *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * @brief   Number of hash buckets to look up reassembly buffer entries
  *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
+ * @note    Must be a power of two
+ */
+#ifndef RBUF_HASH_BUCKETS
+#define RBUF_HASH_BUCKETS   (4U)
+#endif
+
+#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+
+/**
+ * @brief   Number of 8-byte units a datagram can consist of
  *
- * @internal
+ * Fragment offsets are given in 8-byte units, so the coverage of a datagram is
+ * tracked in a bitmap with one bit per unit.
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNITS          ((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U)
 
 /**
  * @brief   Internal representation of the 6LoWPAN reassembly buffer.
@@ -60,11 +64,15 @@ typedef struct rbuf_int {
  *
  * @extends gnrc_sixlowpan_rbuf_t
  */
-typedef struct {
+typedef struct rbuf {
     gnrc_sixlowpan_rbuf_t super;        /**< exposed part of the reassembly buffer */
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+    struct rbuf *next;                  /**< next entry in hash bucket */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+    uint16_t datagram_size;             /**< size of the datagram */
+    BITFIELD(received, RBUF_UNITS);     /**< 8-byte units received */
+    BITFIELD(starts, RBUF_UNITS);       /**< 8-byte units received fragments
+                                         *   start at */
 } rbuf_t;
 
 /**
@@ -84,11 +92,35 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t offset, unsigned page);
 
+/**
+ * @brief   Checks if fragments of a datagram are already in the reassembly
+ *          buffer
+ *
+ * @param[in] netif_hdr     The interface header of a fragment of the datagram.
+ * @param[in] size          The size of the datagram.
+ * @param[in] tag           The tag of the datagram.
+ *
+ * @return  true, if there is an entry for the datagram.
+ * @return  false, otherwise.
+ *
+ * @internal
+ */
+bool rbuf_exists(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag);
+
 /**
  * @brief   Checks timeouts and removes entries if necessary
  */
 void rbuf_gc(void);
 
+/**
+ * @brief   Removes an entry from the reassembly buffer
+ *
+ * @note    The reassembled packet is not released.
+ *
+ * @param[in] rbuf  A reassembly buffer entry.
+ *
+ * @internal
+ */
 void rbuf_rm(rbuf_t *rbuf);
 
 #ifdef __cplusplus
@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#include "rbuf.h"
+#include "vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* an entry expires like a reassembly buffer entry would */
+#define VRB_TIMEOUT     (RBUF_TIMEOUT)
+
+/* maximum size the headers of a first fragment can grow by on decompression */
+#define VRB_HDR_GROWTH  (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t))
+
+static vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static gnrc_sixlowpan_frag_vrb_stats_t _stats;
+
+static inline uint16_t _floor8(uint16_t length)
+{
+    return length & 0xfff8U;
+}
+
+static inline bool _expired(const vrb_t *vrb, uint32_t now_usec)
+{
+    return (now_usec - vrb->arrival) > VRB_TIMEOUT;
+}
+
+/* marks the 8-byte units of a fragment as forwarded, returns the number of
+ * bytes that were not forwarded before */
+static size_t _update_forwarded(vrb_t *vrb, size_t offset, size_t size)
+{
+    size_t end = offset + size, added = 0;
+
+    if (end > vrb->datagram_size) {
+        end = vrb->datagram_size;
+    }
+    /* fragment offsets are multiples of 8 */
+    for (size_t unit = offset / 8U; (unit * 8U) < end; unit++) {
+        if (!bf_isset(vrb->received, unit)) {
+            bf_set(vrb->received, unit);
+            added += ((end - (unit * 8U)) < 8U) ? (end - (unit * 8U)) : 8U;
+        }
+    }
+    return added;
+}
+
+static vrb_t *_vrb_get(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        vrb_t *vrb = &_vrb[i];
+
+        if ((vrb->forwarded > 0) && !_expired(vrb, now_usec) &&
+            (vrb->datagram_size == size) && (vrb->tag == tag) &&
+            (vrb->src_len == netif_hdr->src_l2addr_len) &&
+            (vrb->dst_len == netif_hdr->dst_l2addr_len) &&
+            (memcmp(vrb->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    vrb->src_len) == 0) &&
+            (memcmp(vrb->dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    vrb->dst_len) == 0)) {
+            vrb->arrival = now_usec;
+            return vrb;
+        }
+    }
+    return NULL;
+}
+
+static vrb_t *_vrb_get_free(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].forwarded == 0) || _expired(&_vrb[i], now_usec)) {
+            return &_vrb[i];
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(const vrb_t *vrb)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0,
+                                                 (uint8_t *)vrb->out_dst,
+                                                 vrb->out_dst_len);
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_t *hdr = netif->data;
+
+        hdr->if_pid = vrb->out_pid;
+        if (vrb->forwarded < vrb->datagram_size) {
+            /* Tell the link layer that we will send more fragments */
+            hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+        }
+    }
+    return netif;
+}
+
+static void _send(vrb_t *vrb, gnrc_pktsnip_t *frag)
+{
+    DEBUG("6lo vrb: forward fragment of datagram (tag: %u => %u, "
+          "fragment size: %u)\n", vrb->tag, vrb->out_tag,
+          (unsigned)gnrc_pkt_len(frag->next));
+    _stats.fragments++;
+    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+}
+
+static bool _forward_nth(vrb_t *vrb, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_t *out = gnrc_netif_get_by_pid(vrb->out_pid);
+    sixlowpan_frag_n_t *hdr = pkt->data;
+    size_t offset = hdr->offset * 8U;
+    size_t size = pkt->size - sizeof(sixlowpan_frag_n_t);
+    size_t added;
+    gnrc_pktsnip_t *netif;
+
+    if ((out == NULL) || (pkt->size > out->sixlo.max_frag_size) ||
+        ((offset + size) > vrb->datagram_size)) {
+        DEBUG("6lo vrb: fragment does not fit next hop or datagram, "
+              "discarding datagram\n");
+        vrb->forwarded = 0;
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    /* a duplicate would otherwise count towards the datagram twice and the
+     * entry would be freed before the last fragment arrived */
+    if ((added = _update_forwarded(vrb, offset, size)) == 0) {
+        DEBUG("6lo vrb: ignore duplicate fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    vrb->forwarded += added;
+    netif = _netif_hdr_build(vrb);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    hdr->tag = byteorder_htons(vrb->out_tag);
+    /* exchange link-layer header, the fragment itself is sent as is */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    netif->next = pkt;
+    if (vrb->forwarded >= vrb->datagram_size) {
+        vrb->forwarded = 0;
+    }
+    _send(vrb, netif);
+    return true;
+}
+
+/* decompresses the headers of a first fragment into a packet of its own,
+ * returns NULL on error, with pkt already released if *dropped is set */
+static gnrc_pktsnip_t *_decompress(gnrc_pktsnip_t *pkt, size_t datagram_size,
+                                   bool *dropped)
+{
+    rbuf_t tmp = { .super = { .pkt = NULL } };
+    size_t len = pkt->size - sizeof(sixlowpan_frag_t);
+    gnrc_pktsnip_t *sixlo;
+    ipv6_hdr_t *ipv6_hdr;
+
+    *dropped = false;
+    /* scratch space is always larger than the decompressed fragment, so
+     * gnrc_sixlowpan_iphc_recv() never considers it complete */
+    tmp.super.pkt = gnrc_pktbuf_add(NULL, NULL, len + VRB_HDR_GROWTH,
+                                    GNRC_NETTYPE_IPV6);
+    if (tmp.super.pkt == NULL) {
+        return NULL;
+    }
+    memset(tmp.super.pkt->data, 0, sizeof(ipv6_hdr_t));
+    tmp.super.current_size = len;
+    /* keep original fragment (and its link-layer header) for reassembly */
+    sixlo = gnrc_pktbuf_add(pkt->next,
+                            ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t),
+                            len, GNRC_NETTYPE_SIXLOWPAN);
+    if (sixlo == NULL) {
+        gnrc_pktbuf_release(tmp.super.pkt);
+        return NULL;
+    }
+    gnrc_pktbuf_hold(pkt->next, 1);
+    gnrc_sixlowpan_iphc_recv(sixlo, &tmp.super, 0);
+    if (tmp.super.pkt == NULL) {
+        /* decompression failed, so reassembly would fail as well */
+        *dropped = true;
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    gnrc_pktbuf_realloc_data(tmp.super.pkt, tmp.super.current_size);
+    ipv6_hdr = tmp.super.pkt->data;
+    ipv6_hdr->len = byteorder_htons(datagram_size - sizeof(ipv6_hdr_t));
+    if ((ipv6_hdr->nh == PROTNUM_UDP) &&
+        (tmp.super.current_size >= (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)))) {
+        udp_hdr_t *udp_hdr = (udp_hdr_t *)(ipv6_hdr + 1);
+
+        udp_hdr->length = ipv6_hdr->len;
+    }
+    return tmp.super.pkt;
+}
+
+static bool _forwardable(const ipv6_hdr_t *ipv6_hdr, size_t len)
+{
+    /* same conditions gnrc_ipv6 applies for forwarding. Everything else
+     * (including drops) is left to gnrc_ipv6 after reassembly */
+    return !ipv6_addr_is_multicast(&ipv6_hdr->dst) &&
+           !ipv6_addr_is_loopback(&ipv6_hdr->dst) &&
+           !ipv6_addr_is_link_local(&ipv6_hdr->dst) &&
+           !ipv6_addr_is_link_local(&ipv6_hdr->src) &&
+           (ipv6_hdr->hl > 1) &&
+           (ipv6_hdr->nh != PROTNUM_IPV6_EXT_HOPOPT) &&
+           /* UDP NHC needs the complete UDP header */
+           ((ipv6_hdr->nh != PROTNUM_UDP) ||
+            (len >= (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)))) &&
+           (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) == NULL);
+}
+
+/* sends the recompressed first fragment, splits it in two if it grew beyond
+ * the next hop's maximum fragment size */
+static void _send_1st(vrb_t *vrb, gnrc_pktsnip_t *netif, size_t covered,
+                      size_t max_frag_size)
+{
+    gnrc_pktsnip_t *frag = netif->next, *payload;
+    sixlowpan_frag_t *hdr = frag->data;
+    size_t len = gnrc_pkt_len(frag), hdr_len, payload_len;
+    gnrc_pktsnip_t *netif_n, *frag_n;
+    sixlowpan_frag_n_t *hdr_n;
+    uint16_t split;
+
+    hdr->disp_size = byteorder_htons(vrb->datagram_size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr->tag = byteorder_htons(vrb->out_tag);
+    if (len <= max_frag_size) {
+        _send(vrb, netif);
+        return;
+    }
+    /* after gnrc_sixlowpan_iphc_encode() the IPHC dispatch is followed by at
+     * most one snip of uncompressed payload */
+    payload = frag->next->next;
+    hdr_len = sizeof(sixlowpan_frag_t) + frag->next->size;
+    payload_len = (payload != NULL) ? payload->size : 0;
+    if (hdr_len < max_frag_size) {
+        /* uncompressed offset of the split, must be divisible by 8 */
+        split = _floor8(covered - payload_len + (max_frag_size - hdr_len));
+    }
+    else {
+        split = 0;
+    }
+    if ((split <= (covered - payload_len)) ||
+        ((sizeof(sixlowpan_frag_n_t) + (covered - split)) > max_frag_size)) {
+        DEBUG("6lo vrb: unable to fit first fragment, discarding datagram\n");
+        vrb->forwarded = 0;
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    frag_n = gnrc_pktbuf_add(NULL, NULL,
+                             sizeof(sixlowpan_frag_n_t) + (covered - split),
+                             GNRC_NETTYPE_SIXLOWPAN);
+    netif_n = _netif_hdr_build(vrb);
+    if ((frag_n == NULL) || (netif_n == NULL)) {
+        DEBUG("6lo vrb: error allocating split fragment\n");
+        vrb->forwarded = 0;
+        gnrc_pktbuf_release(frag_n);
+        gnrc_pktbuf_release(netif_n);
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    hdr_n = frag_n->data;
+    hdr_n->disp_size = byteorder_htons(vrb->datagram_size);
+    hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    hdr_n->tag = byteorder_htons(vrb->out_tag);
+    hdr_n->offset = (uint8_t)(split >> 3);
+    memcpy(hdr_n + 1,
+           ((uint8_t *)payload->data) + (payload_len - (covered - split)),
+           covered - split);
+    gnrc_pktbuf_realloc_data(payload, payload_len - (covered - split));
+    netif_n->next = frag_n;
+    _send(vrb, netif);
+    _send(vrb, netif_n);
+}
+
+static bool _forward_1st(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                         size_t datagram_size, uint16_t tag)
+{
+    gnrc_netif_t *in = gnrc_netif_get_by_pid(netif_hdr->if_pid), *out;
+    gnrc_pktsnip_t *ipv6, *payload, *netif, *frag;
+    ipv6_hdr_t *ipv6_hdr;
+    gnrc_ipv6_nib_nc_t nce;
+    size_t covered;
+    vrb_t *vrb;
+    bool dropped;
+
+    if ((in == NULL) || !gnrc_netif_is_rtr(in) ||
+        (pkt->size <= sizeof(sixlowpan_frag_t)) ||
+        !sixlowpan_iphc_is(((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t)) ||
+        rbuf_exists(netif_hdr, datagram_size, tag)) {
+        return false;
+    }
+    if ((ipv6 = _decompress(pkt, datagram_size, &dropped)) == NULL) {
+        return dropped;
+    }
+    ipv6_hdr = ipv6->data;
+    covered = ipv6->size;
+    if (!_forwardable(ipv6_hdr, covered) ||
+        (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                           &nce) < 0) ||
+        ((out = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce))) == NULL) ||
+        !(out->flags & GNRC_NETIF_FLAGS_6LO_HC) ||
+        (out->sixlo.max_frag_size == 0) ||
+        ((vrb = _vrb_get_free()) == NULL)) {
+        DEBUG("6lo vrb: can not forward datagram directly, reassembling\n");
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    /* from here on the original fragment is not needed anymore */
+    memcpy(vrb->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    memcpy(vrb->dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    vrb->src_len = netif_hdr->src_l2addr_len;
+    vrb->dst_len = netif_hdr->dst_l2addr_len;
+    gnrc_pktbuf_release(pkt);
+    memcpy(vrb->out_dst, nce.l2addr, nce.l2addr_len);
+    vrb->out_dst_len = nce.l2addr_len;
+    vrb->out_pid = out->pid;
+    vrb->datagram_size = datagram_size;
+    vrb->tag = tag;
+    vrb->out_tag = gnrc_sixlowpan_frag_next_tag();
+    memset(vrb->received, 0, sizeof(vrb->received));
+    vrb->forwarded = _update_forwarded(vrb, 0, covered);
+    vrb->arrival = xtimer_now_usec();
+    _stats.datagrams++;
+    ipv6_hdr->hl--;
+    /* bring decompressed fragment into sending order expected by
+     * gnrc_sixlowpan_iphc_encode() */
+    if (covered > sizeof(ipv6_hdr_t)) {
+        gnrc_pktsnip_t *hdr = gnrc_pktbuf_mark(ipv6, sizeof(ipv6_hdr_t),
+                                               GNRC_NETTYPE_IPV6);
+
+        if (hdr == NULL) {
+            DEBUG("6lo vrb: unable to mark IPv6 header\n");
+            vrb->forwarded = 0;
+            gnrc_pktbuf_release(ipv6);
+            return true;
+        }
+        payload = ipv6;
+        payload->type = GNRC_NETTYPE_UNDEF;
+        payload->next = NULL;
+        hdr->next = payload;
+        ipv6 = hdr;
+    }
+    netif = _netif_hdr_build(vrb);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        vrb->forwarded = 0;
+        gnrc_pktbuf_release(ipv6);
+        return true;
+    }
+    netif->next = ipv6;
+    if (!gnrc_sixlowpan_iphc_encode(netif)) {
+        DEBUG("6lo vrb: unable to compress IPv6 header\n");
+        vrb->forwarded = 0;
+        return true;
+    }
+    frag = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo vrb: error allocating fragment header\n");
+        vrb->forwarded = 0;
+        gnrc_pktbuf_release(netif);
+        return true;
+    }
+    netif->next = frag;
+    _send_1st(vrb, netif, covered, out->sixlo.max_frag_size);
+    if (vrb->forwarded >= vrb->datagram_size) {
+        vrb->forwarded = 0;
+    }
+    return true;
+}
+
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                 size_t offset)
+{
+    sixlowpan_frag_t *frag = pkt->data;
+    size_t datagram_size = byteorder_ntohs(frag->disp_size) &
+                           SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+    vrb_t *vrb = _vrb_get(netif_hdr, datagram_size, tag);
+
+    if (offset == 0) {
+        if (vrb != NULL) {
+            DEBUG("6lo vrb: first fragment already forwarded, discarding\n");
+            gnrc_pktbuf_release(pkt);
+            return true;
+        }
+        return _forward_1st(netif_hdr, pkt, datagram_size, tag);
+    }
+    else if ((vrb != NULL) && (pkt->size > sizeof(sixlowpan_frag_n_t))) {
+        return _forward_nth(vrb, pkt);
+    }
+    return false;
+}
+
+void vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].forwarded > 0) && _expired(&_vrb[i], now_usec)) {
+            DEBUG("6lo vrb: entry (tag: %u) timed out\n", _vrb[i].tag);
+            _vrb[i].forwarded = 0;
+        }
+    }
+}
+
+const gnrc_sixlowpan_frag_vrb_stats_t *gnrc_sixlowpan_frag_vrb_stats(void)
+{
+    return &_stats;
+}
+
+/** @} */
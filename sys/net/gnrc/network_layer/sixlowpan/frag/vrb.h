@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ */
+#ifndef VRB_H
+#define VRB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitfield.h"
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/ieee802154.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ *
+ * Identifies an incoming datagram the same way as the reassembly buffer does
+ * (see @ref gnrc_sixlowpan_rbuf_t) and maps it to the link it is forwarded
+ * over.
+ *
+ * @internal
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< next hop address */
+    uint8_t src_len;                            /**< length of vrb_t::src */
+    uint8_t dst_len;                            /**< length of vrb_t::dst */
+    uint8_t out_dst_len;                        /**< length of vrb_t::out_dst */
+    kernel_pid_t out_pid;                       /**< interface to next hop */
+    uint16_t datagram_size;                     /**< the datagram's size */
+    uint16_t tag;                               /**< the datagram's tag */
+    uint16_t out_tag;                           /**< tag towards next hop */
+    /**
+     * @brief   The number of bytes of the datagram forwarded so far. 0 if
+     *          the entry is unused.
+     */
+    uint16_t forwarded;
+    uint32_t arrival;                           /**< time in microseconds of
+                                                 *   arrival of last received
+                                                 *   fragment */
+    BITFIELD(received, RBUF_UNITS);             /**< 8-byte units forwarded */
+} vrb_t;
+
+/**
+ * @brief   Forwards a fragment without reassembling its datagram, if possible
+ *
+ * Subsequent fragments are forwarded if an entry for their datagram exists.
+ * A first fragment creates such an entry if the receiving interface is a
+ * router and the datagram is routed over another 6LoWPAN link with a known
+ * next hop.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] pkt           The fragment, starting with the fragment header.
+ * @param[in] offset        The fragment's offset.
+ *
+ * @return  true, if @p pkt was consumed (forwarded or dropped).
+ * @return  false, if @p pkt is to be reassembled.
+ *
+ * @internal
+ */
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                 size_t offset);
+
+/**
+ * @brief   Removes timed out entries
+ *
+ * @internal
+ */
+void vrb_gc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VRB_H */
+/** @} */
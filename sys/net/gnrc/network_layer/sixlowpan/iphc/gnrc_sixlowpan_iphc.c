@@ -30,6 +30,7 @@
 #include "utlist.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/udp.h"
+#include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/iphc.h"
 
@@ -636,71 +637,33 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
-void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+static inline uint32_t _current_minute(void)
 {
-    assert(pkt != NULL);
-    gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr;
-    uint8_t *iphc_hdr;
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
-    bool addr_comp = false;
-    size_t dispatch_size = 0;
-    /* datagram size before compression */
-    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-
-    (void)ctx;
-    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
-    /* determine maximum dispatch size and write protect all headers until
-     * then because they will be removed */
-    while (_compressible(ptr)) {
-        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
-
-        if (tmp == NULL) {
-            DEBUG("6lo iphc: unable to write protect compressible header\n");
-            if (addr_comp) {    /* addr_comp was used as release indicator */
-                gnrc_pktbuf_release(pkt);
-            }
-            return;
-        }
-        ptr = tmp;
-        if (dispatch == NULL) {
-            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
-             * we shouldn't do it again */
-            pkt->next = ptr;    /* reset original packet */
-        }
-        else {
-            dispatch->next = ptr;
-        }
-        if (ptr->type == GNRC_NETTYPE_UNDEF) {
-            /* most likely UDP for now so use that (XXX: extend if extension
-             * headers make problems) */
-            dispatch_size += sizeof(udp_hdr_t);
-            break;  /* nothing special after UDP so quit even if more UNDEF
-                     * come */
-        }
-        else {
-            dispatch_size += ptr->size;
-        }
-        dispatch = ptr; /* use dispatch as temporary point for prev */
-        ptr = ptr->next;
-    }
-    ipv6_hdr = pkt->next->data;
-    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
-                               GNRC_NETTYPE_SIXLOWPAN);
+    return xtimer_now_usec() / (US_PER_SEC * 60);
+}
 
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        gnrc_pktbuf_release(pkt);
-        return;
+/* marks ctx as used for compression, ltime is the minimum lifetime of all
+ * contexts used so far */
+static inline uint8_t _use_ctx(const gnrc_sixlowpan_ctx_t *ctx,
+                               uint16_t *ltime)
+{
+    if (ctx->ltime < *ltime) {
+        *ltime = ctx->ltime;
     }
+    return ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
+}
 
-    iphc_hdr = dispatch->data;
+/* determines the address compression modes (SAC, SAM, M, DAC, and DAM bits of
+ * the second IPHC byte) and the content of the CID extension (0 if not
+ * required) for the addresses of ipv6_hdr */
+static uint8_t _addr_comp(gnrc_netif_hdr_t *netif_hdr, ipv6_hdr_t *ipv6_hdr,
+                          uint8_t *cid, uint16_t *ltime)
+{
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
+    uint8_t iphc2 = 0;
 
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    *cid = 0;
+    *ltime = UINT16_MAX;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -721,95 +684,14 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         }
     }
 
-    /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
-    if (((src_ctx != NULL) &&
-            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
-        ((dst_ctx != NULL) &&
-            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
-        /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
-    }
-
-    /* check for compressible next header */
-    switch (ipv6_hdr->nh) {
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            break;
-#endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
-    }
-
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if (src_ctx != NULL) {
             /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
-
-            if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
-            }
+            iphc2 |= SIXLOWPAN_IPHC2_SAC;
+            *cid |= (_use_ctx(src_ctx, ltime) << 4);
         }
 
         if ((src_ctx != NULL) || ipv6_addr_is_link_local(&(ipv6_hdr->src))) {
@@ -832,39 +714,24 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
-                addr_comp = true;
+                iphc2 |= IPHC_SAC_SAM_L2;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
-                inline_pos += 2;
-                addr_comp = true;
+                iphc2 |= IPHC_SAC_SAM_16;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
-                inline_pos += 8;
-                addr_comp = true;
+                iphc2 |= IPHC_SAC_SAM_64;
             }
         }
-
-        if (!addr_comp) {
-            /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
-            inline_pos += 16;
-        }
+        /* otherwise the full address is carried inline (IPHC_SAC_SAM_FULL) */
     }
 
-    addr_comp = false;
-
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -876,28 +743,18 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
-                addr_comp = true;
+                iphc2 |= IPHC_M_DAC_DAM_M_8;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
-                inline_pos += 3;
-                addr_comp = true;
+                iphc2 |= IPHC_M_DAC_DAM_M_32;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
-                inline_pos += 5;
-                addr_comp = true;
+                iphc2 |= IPHC_M_DAC_DAM_M_48;
             }
         }
         /* try unicast prefix based compression */
@@ -916,15 +773,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
-                if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
-                }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
-                inline_pos += 4;
-                addr_comp = true;
+                iphc2 |= SIXLOWPAN_IPHC2_DAC;
+                *cid |= _use_ctx(ctx, ltime);
             }
         }
     }
@@ -934,11 +784,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
         if (dst_ctx != NULL) {
             /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
-
-            if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
-            }
+            iphc2 |= SIXLOWPAN_IPHC2_DAC;
+            *cid |= _use_ctx(dst_ctx, ltime);
         }
 
         ieee802154_get_iid(&iid, gnrc_netif_hdr_get_dst_addr(netif_hdr),
@@ -947,33 +794,336 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
-            addr_comp = true;
+            iphc2 |= IPHC_M_DAC_DAM_U_L2;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
-            inline_pos += 2;
-            addr_comp = true;
+            iphc2 |= IPHC_M_DAC_DAM_U_16;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
+            iphc2 |= IPHC_M_DAC_DAM_U_64;
+        }
+    }
+    /* otherwise the full destination address is carried inline
+     * (IPHC_M_DAC_DAM_U_FULL) */
+
+    return iphc2;
+}
+
+/* writes the inline parts of the addresses of ipv6_hdr as given by the
+ * compression modes in iphc2, returns the new inline position */
+static uint16_t _addr_inline(uint8_t *iphc_hdr, uint16_t inline_pos,
+                             const ipv6_hdr_t *ipv6_hdr, uint8_t iphc2)
+{
+    switch (iphc2 & (SIXLOWPAN_IPHC2_SAC | SIXLOWPAN_IPHC2_SAM)) {
+        case IPHC_SAC_SAM_FULL:
+            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
+            inline_pos += 16;
+            break;
+        case IPHC_SAC_SAM_64:
+        case IPHC_SAC_SAM_CTX_64:
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
             inline_pos += 8;
-            addr_comp = true;
+            break;
+        case IPHC_SAC_SAM_16:
+        case IPHC_SAC_SAM_CTX_16:
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
+            inline_pos += 2;
+            break;
+        default:
+            /* elided */
+            break;
+    }
+    switch (iphc2 & (SIXLOWPAN_IPHC2_M | SIXLOWPAN_IPHC2_DAC |
+                     SIXLOWPAN_IPHC2_DAM)) {
+        case IPHC_M_DAC_DAM_U_FULL:
+        case IPHC_M_DAC_DAM_M_FULL:
+            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
+            inline_pos += 16;
+            break;
+        case IPHC_M_DAC_DAM_U_64:
+        case IPHC_M_DAC_DAM_U_CTX_64:
+            memcpy(iphc_hdr + inline_pos, &(ipv6_hdr->dst.u8[8]), 8);
+            inline_pos += 8;
+            break;
+        case IPHC_M_DAC_DAM_U_16:
+        case IPHC_M_DAC_DAM_U_CTX_16:
+            memcpy(iphc_hdr + inline_pos, &(ipv6_hdr->dst.u16[7]), 2);
+            inline_pos += 2;
+            break;
+        case IPHC_M_DAC_DAM_M_48:
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
+            inline_pos += 5;
+            break;
+        case IPHC_M_DAC_DAM_M_32:
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
+            inline_pos += 3;
+            break;
+        case IPHC_M_DAC_DAM_M_8:
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
+            break;
+        case IPHC_M_DAC_DAM_M_UC_PREFIX:
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
+            inline_pos += 4;
+            break;
+        default:
+            /* elided */
+            break;
+    }
+    return inline_pos;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+/* compression decisions for a flow */
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    uint8_t src_l2addr[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst_l2addr[IEEE802154_LONG_ADDRESS_LEN];
+    uint32_t expires;       /* minute the contexts used expire */
+    unsigned gen;           /* cache generation the entry is valid for */
+    kernel_pid_t if_pid;
+    uint8_t src_l2addr_len;
+    uint8_t dst_l2addr_len;
+    uint8_t iphc2;
+    uint8_t cid;
+} _cache_entry_t;
+
+static _cache_entry_t _cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static gnrc_sixlowpan_iphc_cache_stats_t _cache_stats;
+static unsigned _cache_next;
+/* all entries of older generations are invalid, never 0 so zeroed entries
+ * are invalid too */
+static volatile unsigned _cache_gen = 1;
+
+static inline bool _cache_match(const _cache_entry_t *entry,
+                                gnrc_netif_hdr_t *netif_hdr,
+                                const ipv6_hdr_t *ipv6_hdr)
+{
+    return (entry->gen == _cache_gen) &&
+           (entry->if_pid == netif_hdr->if_pid) &&
+           (entry->src_l2addr_len == netif_hdr->src_l2addr_len) &&
+           (entry->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+           ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) &&
+           ipv6_addr_equal(&entry->src, &ipv6_hdr->src) &&
+           (memcmp(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   entry->dst_l2addr_len) == 0) &&
+           (memcmp(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                   entry->src_l2addr_len) == 0);
+}
+
+static uint8_t _addr_comp_cached(gnrc_netif_hdr_t *netif_hdr,
+                                 ipv6_hdr_t *ipv6_hdr, uint8_t *cid)
+{
+    _cache_entry_t *entry;
+    uint16_t ltime;
+    uint8_t iphc2;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        entry = &_cache[i];
+        if (_cache_match(entry, netif_hdr, ipv6_hdr)) {
+            if ((int32_t)(entry->expires - _current_minute()) > 0) {
+                _cache_stats.hits++;
+                *cid = entry->cid;
+                return entry->iphc2;
+            }
+            /* a context expired, decide again */
+            entry->gen = 0;
+            break;
+        }
+    }
+    _cache_stats.misses++;
+    iphc2 = _addr_comp(netif_hdr, ipv6_hdr, cid, &ltime);
+    if ((netif_hdr->src_l2addr_len > sizeof(entry->src_l2addr)) ||
+        (netif_hdr->dst_l2addr_len > sizeof(entry->dst_l2addr))) {
+        return iphc2;
+    }
+    entry = &_cache[_cache_next];
+    _cache_next = (_cache_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    memcpy(&entry->src, &ipv6_hdr->src, sizeof(entry->src));
+    memcpy(&entry->dst, &ipv6_hdr->dst, sizeof(entry->dst));
+    memcpy(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    memcpy(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    entry->src_l2addr_len = netif_hdr->src_l2addr_len;
+    entry->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    entry->if_pid = netif_hdr->if_pid;
+    entry->expires = _current_minute() + ltime;
+    entry->iphc2 = iphc2;
+    entry->cid = *cid;
+    entry->gen = _cache_gen;
+    return iphc2;
+}
+
+void gnrc_sixlowpan_iphc_cache_flush(void)
+{
+    unsigned gen = _cache_gen + 1;
+
+    _cache_gen = (gen == 0) ? 1 : gen;
+}
+
+const gnrc_sixlowpan_iphc_cache_stats_t *gnrc_sixlowpan_iphc_cache_stats(void)
+{
+    return &_cache_stats;
+}
+#else
+static inline uint8_t _addr_comp_cached(gnrc_netif_hdr_t *netif_hdr,
+                                        ipv6_hdr_t *ipv6_hdr, uint8_t *cid)
+{
+    uint16_t ltime;
+
+    return _addr_comp(netif_hdr, ipv6_hdr, cid, &ltime);
+}
+#endif
+
+bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+{
+    assert(pkt != NULL);
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    ipv6_hdr_t *ipv6_hdr;
+    uint8_t *iphc_hdr;
+    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
+    size_t dispatch_size = 0;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    uint8_t iphc2, cid;
+
+    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
+    /* determine maximum dispatch size and write protect all headers until
+     * then because they will be removed */
+    while (_compressible(ptr)) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
+
+        if (tmp == NULL) {
+            DEBUG("6lo iphc: unable to write protect compressible header\n");
+            gnrc_pktbuf_release(pkt);
+            return false;
+        }
+        ptr = tmp;
+        if (dispatch == NULL) {
+            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
+             * we shouldn't do it again */
+            pkt->next = ptr;    /* reset original packet */
+        }
+        else {
+            dispatch->next = ptr;
+        }
+        if (ptr->type == GNRC_NETTYPE_UNDEF) {
+            /* most likely UDP for now so use that (XXX: extend if extension
+             * headers make problems) */
+            dispatch_size += sizeof(udp_hdr_t);
+            break;  /* nothing special after UDP so quit even if more UNDEF
+                     * come */
+        }
+        else {
+            dispatch_size += ptr->size;
+        }
+        dispatch = ptr; /* use dispatch as temporary point for prev */
+        ptr = ptr->next;
+    }
+    ipv6_hdr = pkt->next->data;
+    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
+                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+
+    iphc_hdr = dispatch->data;
+
+    /* address compression only depends on the addresses and the interface,
+     * so it is decided up front (and possibly cached for the flow) */
+    iphc2 = _addr_comp_cached(netif_hdr, ipv6_hdr, &cid);
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = iphc2;
+
+    /* if contexts with ID != 0 are used */
+    /* since this moves inline_pos we have to do this ahead*/
+    if (cid != 0) {
+        /* add context identifier extension */
+        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
+        iphc_hdr[CID_EXT_IDX] = cid;
+
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
         }
     }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
 
-    if (!addr_comp) {
-        /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
-        inline_pos += 16;
+        /* copy remaining byteos of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
     }
 
+    /* check for compressible next header */
+    switch (ipv6_hdr->nh) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        case PROTNUM_UDP:
+            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+            break;
+#endif
+
+        default:
+            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+            break;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
+    }
+
+    inline_pos = _addr_inline(iphc_hdr, inline_pos, ipv6_hdr, iphc2);
+
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
     switch (ipv6_hdr->nh) {
         case PROTNUM_UDP: {
@@ -989,7 +1139,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 if (udp == NULL) {
                     DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
                     gnrc_pktbuf_release(dispatch);
-                    return;
+                    gnrc_pktbuf_release(pkt);
+                    return false;
                 }
             }
             gnrc_pktbuf_remove_snip(pkt, udp);
@@ -1010,8 +1161,22 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* insert dispatch into packet */
     dispatch->next = pkt->next;
     pkt->next = dispatch;
+    return true;
+}
 
-    gnrc_netif_t *netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
+void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    assert(pkt != NULL);
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    gnrc_netif_t *netif;
+    /* datagram size before compression */
+    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
+
+    (void)ctx;
+    if (!gnrc_sixlowpan_iphc_encode(pkt)) {
+        return;
+    }
+    netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
     assert(netif != NULL);
     gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
 }
@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer backend using size-class slabs
+ *
+ * Every size class is a static array of equally sized blocks with a free list
+ * threaded through the unused blocks. Data blocks carry a reference counter,
+ * so @ref gnrc_pktbuf_mark() can hand out the front of a block to the marked
+ * snip while the remainder keeps pointing into the same block.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+typedef struct _free_block {
+    struct _free_block *next;
+} _free_block_t;
+
+#define _ALIGNMENT_MASK    (sizeof(_free_block_t) - 1)
+#define _SNIP_SIZE         ((sizeof(gnrc_pktsnip_t) + _ALIGNMENT_MASK) & \
+                            ~(_ALIGNMENT_MASK))
+
+/**
+ * @brief   Size class descriptor
+ */
+typedef struct {
+    uint8_t *pool;          /**< first block of the class */
+    uint8_t *refs;          /**< reference counter of each block */
+    uint16_t *len;          /**< bytes requested for each block */
+    _free_block_t *free;    /**< first free block */
+    uint16_t size;          /**< size of a block */
+    uint16_t numof;         /**< number of blocks */
+#ifdef DEVELHELP
+    uint16_t used;          /**< blocks currently in use */
+    uint16_t max_used;      /**< high-water mark of blocks in use */
+    uint16_t fallbacks;     /**< requests served by a larger class */
+    uint16_t fails;         /**< requests that could not be served */
+#endif
+} _slab_t;
+
+#define _SLAB_POOL(name, size, numof) \
+    static _free_block_t _ ## name ## _pool[((size) * (numof)) / \
+                                            sizeof(_free_block_t)]; \
+    static uint8_t _ ## name ## _refs[numof]; \
+    static uint16_t _ ## name ## _len[numof]
+
+#define _SLAB(name, bsize, num)  { .pool = (uint8_t *)_ ## name ## _pool, \
+                                   .refs = _ ## name ## _refs, \
+                                   .len = _ ## name ## _len, \
+                                   .size = (bsize), \
+                                   .numof = (num) }
+
+_SLAB_POOL(snip, _SNIP_SIZE, GNRC_PKTBUF_SLAB_SNIP_NUMOF);
+_SLAB_POOL(small, GNRC_PKTBUF_SLAB_SMALL_SIZE, GNRC_PKTBUF_SLAB_SMALL_NUMOF);
+_SLAB_POOL(frame, GNRC_PKTBUF_SLAB_FRAME_SIZE, GNRC_PKTBUF_SLAB_FRAME_NUMOF);
+_SLAB_POOL(mtu, GNRC_PKTBUF_SLAB_MTU_SIZE, GNRC_PKTBUF_SLAB_MTU_NUMOF);
+
+/* data classes must be sorted by ascending block size */
+static _slab_t _slabs[] = {
+    _SLAB(snip, _SNIP_SIZE, GNRC_PKTBUF_SLAB_SNIP_NUMOF),
+    _SLAB(small, GNRC_PKTBUF_SLAB_SMALL_SIZE, GNRC_PKTBUF_SLAB_SMALL_NUMOF),
+    _SLAB(frame, GNRC_PKTBUF_SLAB_FRAME_SIZE, GNRC_PKTBUF_SLAB_FRAME_NUMOF),
+    _SLAB(mtu, GNRC_PKTBUF_SLAB_MTU_SIZE, GNRC_PKTBUF_SLAB_MTU_NUMOF),
+};
+
+#define _SLAB_SNIP         (0U)
+#define _SLAB_DATA         (1U)
+#define _SLAB_NUMOF        (sizeof(_slabs) / sizeof(_slabs[0]))
+#define _MAX_DATA_SIZE     (_slabs[_SLAB_NUMOF - 1].size)
+
+static mutex_t _mutex = MUTEX_INIT;
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data);
+
+static inline bool _slab_contains(const _slab_t *slab, const void *ptr)
+{
+    return (size_t)((const uint8_t *)ptr - slab->pool) <
+           ((size_t)slab->size * slab->numof);
+}
+
+static _slab_t *_slab_of(const void *ptr, unsigned *idx)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        if (_slab_contains(slab, ptr)) {
+            *idx = ((const uint8_t *)ptr - slab->pool) / slab->size;
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline bool _pktbuf_contains(const void *ptr)
+{
+    unsigned idx;
+
+    return _slab_of(ptr, &idx) != NULL;
+}
+
+static void *_slab_take(_slab_t *slab, size_t size)
+{
+    _free_block_t *block = slab->free;
+    unsigned idx = ((uint8_t *)block - slab->pool) / slab->size;
+
+    assert(block != NULL);
+    slab->free = block->next;
+    slab->refs[idx] = 1;
+    slab->len[idx] = size;
+#ifdef DEVELHELP
+    if (++slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+#endif
+    return block;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        assert((slab->size & _ALIGNMENT_MASK) == 0);
+        assert((i <= _SLAB_DATA) || (slab->size > _slabs[i - 1].size));
+        slab->free = NULL;
+        for (unsigned j = slab->numof; j > 0; j--) {
+            _free_block_t *block = (_free_block_t *)(slab->pool +
+                                                     ((j - 1) * slab->size));
+            block->next = slab->free;
+            slab->free = block;
+        }
+        memset(slab->refs, 0, slab->numof);
+#ifdef DEVELHELP
+        slab->used = 0;
+        slab->max_used = 0;
+        slab->fallbacks = 0;
+        slab->fails = 0;
+#endif
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _MAX_DATA_SIZE) {
+        DEBUG("pktbuf: size (%u) > largest size class (%u)\n",
+              (unsigned)size, (unsigned)_MAX_DATA_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(0);
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    new_data_marked = pkt->data;
+    if (pkt->size != size) {
+        unsigned idx;
+        _slab_t *slab = _slab_of(pkt->data, &idx);
+
+        /* both snips now point into the same block */
+        assert(slab != NULL);
+        slab->refs[idx]++;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if (size > pkt->size) {
+        unsigned idx = 0;
+        _slab_t *slab = (pkt->data != NULL) ? _slab_of(pkt->data, &idx) : NULL;
+        size_t offset = (slab != NULL) ?
+                        (size_t)((uint8_t *)pkt->data - slab->pool) % slab->size : 0;
+
+        /* grow in place if no other snip shares the block and it is big
+         * enough */
+        if ((slab != NULL) && (slab->refs[idx] == 1) &&
+            ((offset + size) <= slab->size)) {
+            slab->len[idx] = offset + size;
+        }
+        else {
+            void *new_data = _pktbuf_alloc(size);
+
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                mutex_unlock(&_mutex);
+                return ENOMEM;
+            }
+            if (pkt->data != NULL) {            /* if old data exist */
+                memcpy(new_data, pkt->data, pkt->size);
+            }
+            _pktbuf_free(pkt->data);
+            pkt->data = new_data;
+        }
+    }
+    /* shrinking keeps the block, a block can only be released as a whole */
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    mutex_lock(&_mutex);
+    puts("packet buffer: slab allocator");
+    puts("class | block | numof | used | max used | fallbacks | fails | "
+         "fragmentation");
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned requested = 0;
+
+        for (unsigned j = 0; j < slab->numof; j++) {
+            if (slab->refs[j] > 0) {
+                requested += slab->len[j];
+            }
+        }
+        printf("%5s | %5u | %5u | %4u | %8u | %9u | %5u | %6u B\n",
+               (i == _SLAB_SNIP) ? "snip" : "data",
+               slab->size, slab->numof, slab->used, slab->max_used,
+               slab->fallbacks, slab->fails,
+               ((unsigned)slab->used * slab->size) - requested);
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        for (unsigned j = 0; j < _slabs[i].numof; j++) {
+            if (_slabs[i].refs[j] > 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall blocks in a free list: block is at a block boundary of its
+     *    class and its reference counter is 0
+     *  - forall classes: number of free blocks + number of referenced blocks
+     *    == number of blocks
+     */
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned free = 0, referenced = 0;
+
+        for (_free_block_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            size_t offset = (uint8_t *)ptr - slab->pool;
+
+            if (!_slab_contains(slab, ptr) || ((offset % slab->size) != 0) ||
+                (slab->refs[offset / slab->size] != 0) ||
+                (++free > slab->numof)) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < slab->numof; j++) {
+            if (slab->refs[j] > 0) {
+                referenced++;
+            }
+        }
+        if ((free + referenced) != slab->numof) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(0);
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+/* allocates a packet snip for size == 0, a data block otherwise */
+static void *_pktbuf_alloc(size_t size)
+{
+    _slab_t *fit = NULL;
+
+    if (size == 0) {
+        _slab_t *slab = &_slabs[_SLAB_SNIP];
+
+        if (slab->free != NULL) {
+            return _slab_take(slab, sizeof(gnrc_pktsnip_t));
+        }
+        fit = slab;
+    }
+    else {
+        for (unsigned i = _SLAB_DATA; i < _SLAB_NUMOF; i++) {
+            _slab_t *slab = &_slabs[i];
+
+            if (size > slab->size) {
+                continue;
+            }
+            if (fit == NULL) {
+                fit = slab;
+            }
+            if (slab->free != NULL) {
+#ifdef DEVELHELP
+                if (slab != fit) {
+                    fit->fallbacks++;
+                }
+#endif
+                return _slab_take(slab, size);
+            }
+        }
+    }
+    DEBUG("pktbuf: no space left in packet buffer\n");
+#ifdef DEVELHELP
+    if (fit != NULL) {
+        fit->fails++;
+    }
+#endif
+    return NULL;
+}
+
+/* releases one reference to the block data points into */
+static void _pktbuf_free(void *data)
+{
+    unsigned idx;
+    _slab_t *slab;
+
+    if ((data == NULL) || ((slab = _slab_of(data, &idx)) == NULL)) {
+        return;
+    }
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _free_block_t *block = (_free_block_t *)(slab->pool + (idx * slab->size));
+
+        block->next = slab->free;
+        slab->free = block;
+#ifdef DEVELHELP
+        slab->used--;
+#endif
+    }
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
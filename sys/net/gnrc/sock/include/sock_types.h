@@ -31,6 +31,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +43,18 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+#ifdef MODULE_SOCK_ASYNC
+struct gnrc_sock_reg;
+
+/**
+ * @brief   Event callback for @ref gnrc_sock_reg_t
+ * @internal
+ */
+typedef void (*gnrc_sock_reg_cb_t)(struct gnrc_sock_reg *sock,
+                                   sock_async_flags_t flags,
+                                   void *arg);
+#endif
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
@@ -51,6 +66,18 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+#ifdef MODULE_SOCK_ASYNC
+    gnrc_netreg_entry_cbd_t netreg_cb;  /**< netreg callback filling the mbox */
+    /**
+     * @brief   asynchronous event callback
+     */
+    union {
+        gnrc_sock_reg_cb_t generic;     /**< generic version */
+        sock_ip_cb_t ip;                /**< raw IP version */
+        sock_udp_cb_t udp;              /**< UDP version */
+    } async_cb;
+    void *async_cb_arg;                 /**< argument for gnrc_sock_reg_t::async_cb */
+#endif
 } gnrc_sock_reg_t;
 
 /**
@@ -22,6 +22,7 @@
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/sock/ip.h"
+#include "net/sock/async.h"
 #include "random.h"
 
 #include "gnrc_sock_internal.h"
@@ -193,7 +194,21 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     if (res <= 0) {
         return res;
     }
+#ifdef MODULE_SOCK_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb.ip != NULL)) {
+        sock->reg.async_cb.ip(sock, SOCK_ASYNC_MSG_SENT, sock->reg.async_cb_arg);
+    }
+#endif
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb.ip = cb;
+    sock->reg.async_cb_arg = cb_arg;
+}
+#endif
+
 /** @} */
@@ -23,6 +23,7 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
 #include "net/sock/udp.h"
+#include "net/sock/async.h"
 #include "net/udp.h"
 
 #include "gnrc_sock_internal.h"
@@ -174,15 +175,15 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/* receives a packet for sock and checks it against the remote of sock */
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -191,10 +192,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -213,9 +210,57 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    *pkt_out = pkt;
+    return 0;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (pkt->size > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
     memcpy(data, pkt->data, pkt->size);
+    res = (ssize_t)pkt->size;
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the payload is always handed out as a whole, so release it */
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (pkt->size == 0) {
+        *data = NULL;
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
@@ -314,8 +359,23 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
+#ifdef MODULE_SOCK_ASYNC
+        if ((sock != NULL) && (sock->reg.async_cb.udp != NULL)) {
+            sock->reg.async_cb.udp(sock, SOCK_ASYNC_MSG_SENT,
+                                   sock->reg.async_cb_arg);
+        }
+#endif
     }
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb.udp = cb;
+    sock->reg.async_cb_arg = cb_arg;
+}
+#endif
+
 /** @} */
@@ -132,6 +132,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
     }
 
     /* Mark TCB as waiting for incomming messages */
+    tcb->status &= ~STATUS_TIMED_OUT;
     tcb->status |= STATUS_WAIT_FOR_MSG;
 
     /* 'Flush' mbox */
@@ -336,7 +337,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     /* Check if connection is in a valid state */
     if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_CLOSE_WAIT) {
         mutex_unlock(&(tcb->function_lock));
-        return -ENOTCONN;
+        return (tcb->status & STATUS_TIMED_OUT) ? -ETIMEDOUT : -ENOTCONN;
     }
 
     /* Mark TCB as waiting for incomming messages */
@@ -355,11 +356,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
-        /* Check if the connections state is closed. If so, a reset was received */
+    /* Loop until something was queued for transmission */
+    while (ret == 0) {
+        /* Check if the connections state is closed. If so, a reset was received
+         * or the peer stopped acknowledging retransmissions */
         if (tcb->state == FSM_STATE_CLOSED) {
-            ret = -ECONNRESET;
+            ret = (tcb->status & STATUS_TIMED_OUT) ? -ETIMEDOUT : -ECONNRESET;
             break;
         }
 
@@ -378,6 +380,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         /* Try to send data in case there nothing has been sent and we are not probing */
         if (ret == 0 && !probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+
+            /* Data is retransmitted until acknowledged, no need to wait for that */
+            if (ret > 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -391,7 +398,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 ret = -ETIMEDOUT;
                 break;
 
@@ -458,7 +464,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_FIN_WAIT_1 &&
         tcb->state != FSM_STATE_FIN_WAIT_2 && tcb->state != FSM_STATE_CLOSE_WAIT) {
         mutex_unlock(&(tcb->function_lock));
-        return -ENOTCONN;
+        return (tcb->status & STATUS_TIMED_OUT) ? -ETIMEDOUT : -ENOTCONN;
     }
 
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
@@ -487,9 +493,10 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
     /* Processing loop */
     while (ret == 0) {
-        /* Check if the connections state is closed. If so, a reset was received */
+        /* Check if the connections state is closed. If so, a reset was received
+         * or the peer stopped acknowledging retransmissions */
         if (tcb->state == FSM_STATE_CLOSED) {
-            ret = -ECONNRESET;
+            ret = (tcb->status & STATUS_TIMED_OUT) ? -ETIMEDOUT : -ECONNRESET;
             break;
         }
 
@@ -508,7 +515,6 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
                     DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                     ret = -ETIMEDOUT;
                     break;
 
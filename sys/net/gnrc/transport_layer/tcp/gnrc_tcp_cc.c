@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+
+#include "net/gnrc.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Upper bound of the congestion window: the largest receive window a
+ *        peer can announce without window scaling.
+ */
+#define CWND_MAX (UINT16_MAX)
+
+/**
+ * @brief Get the sender maximum segment size (SMSS).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The size of the largest segment that is sent.
+ */
+static inline uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Get the number of bytes in flight.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of sent but unacknowledged bytes.
+ */
+static inline uint32_t _flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+/**
+ * @brief Sets the slow start threshold after a loss was detected (RFC 5681, eq. 4).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _reduce_ssthresh(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half = _flight_size(tcb) / 2;
+
+    tcb->ssthresh = (half > 2 * _smss(tcb)) ? half : 2 * _smss(tcb);
+}
+
+/**
+ * @brief Retransmits a segment of the retransmission queue without timer backoff.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     idx   Index of the segment in the retransmission queue.
+ */
+static void _retransmit(gnrc_tcp_tcb_t *tcb, uint8_t idx)
+{
+    /* Every send attempt consumes a user */
+    gnrc_pktbuf_hold(tcb->rtx_queue[idx], 1);
+    _pkt_send(tcb, tcb->rtx_queue[idx], 0, true);
+    tcb->rtx_flags[idx] |= RTX_FLAG_RESENT;
+}
+
+/**
+ * @brief Retransmits the oldest unacknowledged segment without timer backoff.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _retransmit_oldest(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->rtx_numof > 0) {
+        _retransmit(tcb, tcb->rtx_head);
+    }
+}
+
+/**
+ * @brief Retransmits the oldest segment in front of selectively acknowledged
+ *        data that was not retransmitted during this recovery yet (RFC 6675).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _retransmit_hole(gnrc_tcp_tcb_t *tcb)
+{
+    int last_sacked = -1;
+
+    for (uint8_t i = 0; i < tcb->rtx_numof; i++) {
+        if (tcb->rtx_flags[(tcb->rtx_head + i) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE] &
+            RTX_FLAG_SACKED) {
+            last_sacked = i;
+        }
+    }
+    for (int i = 0; i < last_sacked; i++) {
+        uint8_t idx = (tcb->rtx_head + i) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE;
+
+        if (!(tcb->rtx_flags[idx] & (RTX_FLAG_SACKED | RTX_FLAG_RESENT))) {
+            _retransmit(tcb, idx);
+            return;
+        }
+    }
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window (RFC 5681, 3.1) */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = CWND_MAX;
+    tcb->recover = tcb->snd_una;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_init() : cwnd=%" PRIu32 "\n", tcb->cwnd);
+}
+
+uint32_t _cc_get_send_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd = (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+    uint32_t flight = _flight_size(tcb);
+
+    return (wnd > flight) ? (wnd - flight) : 0;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+
+    tcb->dup_acks = 0;
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: deflate the window and leave fast recovery */
+        if (LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+            uint32_t flight = _flight_size(tcb);
+
+            flight = (flight > smss) ? flight : smss;
+            tcb->cwnd = (tcb->ssthresh < flight + smss) ? tcb->ssthresh : flight + smss;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : full ACK, cwnd=%" PRIu32 "\n", tcb->cwnd);
+        }
+        /* Partial acknowledgment: the next segment was lost as well (RFC 6582, 3.2) */
+        else {
+            /* The oldest segment might be in flight already, if SACK revealed the hole */
+            if (tcb->rtx_flags[tcb->rtx_head] & RTX_FLAG_RESENT) {
+                _retransmit_hole(tcb);
+            }
+            else {
+                _retransmit_oldest(tcb);
+            }
+            tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : partial ACK, cwnd=%" PRIu32 "\n", tcb->cwnd);
+        }
+        return;
+    }
+
+    /* Recovering from a retransmission timeout: segments sent before the
+     * timeout are assumed to be lost, resend them one by one */
+    if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+        _retransmit_oldest(tcb);
+    }
+
+    /* Slow start */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: grow about one SMSS per round trip time */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+    if (tcb->cwnd > CWND_MAX) {
+        tcb->cwnd = CWND_MAX;
+    }
+}
+
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->dup_acks < UINT8_MAX) {
+        tcb->dup_acks += 1;
+    }
+
+    /* Each further duplicate ACK signals a segment that left the network,
+     * use it to fill a further hole reported by SACK */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+        _retransmit_hole(tcb);
+        return;
+    }
+
+    /* Fast retransmit, unless the ACKs belong to a previous recovery (RFC 6582, 3.2) */
+    if ((tcb->dup_acks == GNRC_TCP_DUP_ACK_THRESHOLD) &&
+        LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+        _reduce_ssthresh(tcb);
+        tcb->recover = tcb->snd_nxt;
+        _retransmit_oldest(tcb);
+        tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUP_ACK_THRESHOLD * smss;
+        tcb->status |= STATUS_FAST_RECOVERY;
+        DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : fast retransmit, cwnd=%" PRIu32 "\n",
+              tcb->cwnd);
+    }
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Keep ssthresh if the oldest segment timed out before (RFC 5681, 3.1) */
+    if (tcb->retries == 0) {
+        _reduce_ssthresh(tcb);
+    }
+    tcb->cwnd = _smss(tcb);
+    tcb->recover = tcb->snd_nxt;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+
+    /* Retransmissions of the last recovery are assumed to be lost as well */
+    for (uint8_t i = 0; i < GNRC_TCP_RETRANSMIT_QUEUE_SIZE; i++) {
+        tcb->rtx_flags[i] &= ~RTX_FLAG_RESENT;
+    }
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout() : ssthresh=%" PRIu32 "\n", tcb->ssthresh);
+}
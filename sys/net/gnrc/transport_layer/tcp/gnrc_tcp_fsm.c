@@ -23,6 +23,7 @@
 #include "net/af.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
+#include "internal/cc.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
@@ -40,6 +41,10 @@
  */
 #define TCB_EQUAL(a,b)      ((a) != (b))
 
+#if GNRC_TCP_RETRANSMIT_QUEUE_SIZE < 2
+#error "GNRC_TCP_RETRANSMIT_QUEUE_SIZE must hold at least one data segment and a FIN"
+#endif
+
 /**
  * @brief Checks if a given port number is currently used by a TCB as local_port.
  *
@@ -83,11 +88,17 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    gnrc_pktsnip_t *pkt = NULL;
+
+    if (tcb->rtx_numof > 0) {
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
     }
+    while ((pkt = _pkt_get_retransmit(tcb)) != NULL) {
+        gnrc_pktbuf_release(pkt);
+        tcb->rtx_head = (tcb->rtx_head + 1) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE;
+        tcb->rtx_numof -= 1;
+    }
+    tcb->status &= ~STATUS_RTT_MEASURE;
     return 0;
 }
 
@@ -147,6 +158,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             }
 #endif
             tcb->peer_port = PORT_UNSPEC;
+            tcb->status &= ~STATUS_SACK_PERMITTED;
 
             /* Allocate receive buffer */
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
@@ -163,6 +175,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_SENT:
+            tcb->status &= ~STATUS_SACK_PERMITTED;
+
             /* Allocate rceveive buffer */
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
@@ -193,6 +207,10 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 
         case FSM_STATE_ESTABLISHED:
         case FSM_STATE_CLOSE_WAIT:
+            /* Connection was synchronized: Start with the initial congestion window */
+            if (tcb->state == FSM_STATE_SYN_SENT || tcb->state == FSM_STATE_SYN_RCVD) {
+                _cc_init(tcb);
+            }
             tcb->status |= STATUS_NOTIFY_USER;
             break;
 
@@ -266,24 +284,34 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t mss = (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+    size_t sent = 0;
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+    /* Send segments while the windows are open, keep one retransmit slot for the FIN */
+    while (sent < len && tcb->rtx_numof < GNRC_TCP_RETRANSMIT_QUEUE_SIZE - 1) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = _cc_get_send_wnd(tcb);
+        payload = (payload < mss) ? payload : mss;
+        payload = (payload < len - sent) ? payload : len - sent;
 
-        /* Calculate payload size for this segment */
+        /* Avoid small segments while data is in flight (Silly Window Syndrome) */
+        if (payload == 0 || (payload < mss && payload < len - sent &&
+                             tcb->snd_nxt != tcb->snd_una)) {
+            break;
+        }
+
+        /* Build and send segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -630,8 +658,20 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+
+                    /* Signal user: the send window moved */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: A segment after snd_una arrived at the peer (RFC 5681) */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && !(ctl & MSK_FIN) &&
+                         seg_wnd == tcb->snd_wnd && tcb->rtx_numof > 0) {
+                    _cc_dup_ack(tcb);
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -655,25 +695,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_numof == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_numof == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_numof == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_numof == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -688,21 +728,17 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Copy new data into receive buffer, keep segments after a gap aside */
+                if (_rcvbuf_add_segment(tcb, in_pkt, seg_seq) > 0) {
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+                /* A FIN behind missing data is ignored, the peer retransmits it */
+                if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                    ctl &= ~MSK_FIN;
+                }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -718,6 +754,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* A FIN behind missing data is ignored, acknowledge what was received */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -727,7 +769,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_numof == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -769,9 +811,21 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    gnrc_pktsnip_t *pkt = _pkt_get_retransmit(tcb);
+
+    if (pkt != NULL && tcb->retries >= GNRC_TCP_RETRANSMIT_MAX) {
+        /* The peer did not acknowledge anything for too long: Give up */
+        DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Too many retransmissions\n");
+        tcb->status |= STATUS_TIMED_OUT;
+        _transition_to(tcb, FSM_STATE_CLOSED);
+    }
+    else if (pkt != NULL) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, pkt, true);
+        /* Only timeouts count for the timer backoff, not the retransmissions
+         * of congestion control */
+        tcb->retries += 1;
+        _pkt_send(tcb, pkt, 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -16,12 +16,27 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief Reads a 32-bit value in network byte order from an option field.
+ *
+ * @param[in] buf   Start of the value.
+ *
+ * @returns   Value in host byte order.
+ */
+static inline uint32_t _get_u32(const uint8_t *buf)
+{
+    return ((uint32_t) buf[0] << 24) | ((uint32_t) buf[1] << 16) |
+           ((uint32_t) buf[2] << 8) | buf[3];
+}
+
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     /* Extract offset value. Return if no options are set */
@@ -60,6 +75,33 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted length.\n");
+                    return -1;
+                }
+                /* SACK is negotiated during connection setup only */
+                if (byteorder_ntohs(hdr->off_ctl) & MSK_SYN) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found.\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (option->length < 2 + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    option->length > opt_left ||
+                    (option->length - 2) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                if (tcb->status & STATUS_SACK_PERMITTED) {
+                    for (uint8_t i = 0; i < option->length - 2; i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        _pkt_sack(tcb, _get_u32(option->value + i), _get_u32(option->value + i + 4));
+                    }
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found.\n");
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -69,3 +111,64 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     }
     return 0;
 }
+
+size_t _option_build_sack(const gnrc_tcp_tcb_t *tcb, uint8_t *opt, size_t len)
+{
+    uint32_t blocks[GNRC_TCP_OOO_QUEUE_SIZE][2];
+    uint8_t numof = 0;
+    uint8_t first = 0;
+    uint8_t max = 0;
+
+    if (!(tcb->status & STATUS_SACK_PERMITTED) || tcb->ooo_numof == 0 ||
+        len < 4 + TCP_OPTION_LENGTH_SACK_BLOCK) {
+        return 0;
+    }
+
+    /* Merge adjacent segments into blocks, the queue is sorted by sequence number */
+    for (uint8_t i = 0; i < tcb->ooo_numof; i++) {
+        gnrc_pktsnip_t *pkt = tcb->ooo_queue[i];
+        uint32_t left = _pkt_get_seq_num(pkt);
+        uint32_t right = left + _pkt_get_pay_len(pkt);
+
+        if (numof > 0 && LEQ_32_BIT(left, blocks[numof - 1][1])) {
+            if (LSS_32_BIT(blocks[numof - 1][1], right)) {
+                blocks[numof - 1][1] = right;
+            }
+        }
+        else {
+            blocks[numof][0] = left;
+            blocks[numof][1] = right;
+            numof += 1;
+        }
+        if (INSIDE_WND(blocks[numof - 1][0], tcb->ooo_recent, blocks[numof - 1][1])) {
+            first = numof - 1;
+        }
+    }
+
+    /* Limit number of blocks to the available space */
+    max = (len - 4) / TCP_OPTION_LENGTH_SACK_BLOCK;
+    max = (max < OPTION_SACK_BLOCKS_MAX) ? max : OPTION_SACK_BLOCKS_MAX;
+    numof = (numof < max) ? numof : max;
+    if (first >= numof) {
+        /* Replace the last block with the block holding the latest segment */
+        blocks[numof - 1][0] = blocks[first][0];
+        blocks[numof - 1][1] = blocks[first][1];
+        first = numof - 1;
+    }
+
+    /* Write two NOP options for alignment, the SACK option header and the blocks */
+    opt[0] = TCP_OPTION_KIND_NOP;
+    opt[1] = TCP_OPTION_KIND_NOP;
+    opt[2] = TCP_OPTION_KIND_SACK;
+    opt[3] = 2 + numof * TCP_OPTION_LENGTH_SACK_BLOCK;
+    for (uint8_t i = 0, pos = 4; i < numof; i++, pos += TCP_OPTION_LENGTH_SACK_BLOCK) {
+        uint8_t block = (i == 0) ? first : ((i <= first) ? i - 1 : i);
+        network_uint32_t edge;
+
+        edge = byteorder_htonl(blocks[block][0]);
+        memcpy(opt + pos, &edge, sizeof(edge));
+        edge = byteorder_htonl(blocks[block][1]);
+        memcpy(opt + pos + sizeof(edge), &edge, sizeof(edge));
+    }
+    return 4 + numof * TCP_OPTION_LENGTH_SACK_BLOCK;
+}
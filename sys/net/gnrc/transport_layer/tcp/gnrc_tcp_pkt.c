@@ -147,6 +147,9 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint8_t sack[OPTION_SACK_SIZE_MAX];
+    size_t sack_len = 0;
+    bool sack_perm = false;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -171,6 +174,16 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+        /* Offer SACK in SYN, accept it in SYN+ACK only if the peer offered it */
+        if (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED)) {
+            sack_perm = true;
+            offset += 1;
+        }
+    }
+    /* Report out-of-order data in pure ACKs */
+    else if (ctl == MSK_ACK && payload_len == 0) {
+        sack_len = _option_build_sack(tcb, sack, sizeof(sack));
+        offset += sack_len / sizeof(network_uint32_t);
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
@@ -196,8 +209,19 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            /* Add SACK permitted option */
+            if (sack_perm) {
+                network_uint32_t sack_perm_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+            }
+            /* Add SACK blocks */
+            if (sack_len > 0) {
+                memcpy(opt_ptr, sack, sack_len);
+                opt_ptr += sack_len;
             }
-            /* Increase opt_ptr and decrease opt_ptr, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -262,12 +286,17 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
+        /* Only one segment at a time is used for round trip time measurement */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+            tcb->rtt_start = xtimer_now().ticks32;
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
     else {
-        tcb->retries += 1;
+        /* Retransmitted segments are ambiguous for measurement (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_MEASURE;
     }
 
     /* Pass packet down the network stack */
@@ -326,6 +355,14 @@ uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt)
     return seq;
 }
 
+uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
 uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
 {
     uint32_t seg_len = 0;
@@ -339,6 +376,43 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the retransmission timeout from the current rtt estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _rto_calc(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no measurement yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief (Re)starts the retransmission timer with the current retransmission timeout.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _rto_timer_set(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -351,12 +425,6 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -367,21 +435,34 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+        /* Check if retransmit queue is full */
+        if (tcb->rtx_numof >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+            return -ENOMEM;
         }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+
+        /* Append pkt and increase users: every send attempt consumes a user */
+        uint8_t idx = (tcb->rtx_head + tcb->rtx_numof) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE;
+        tcb->rtx_queue[idx] = pkt;
+        tcb->rtx_flags[idx] = 0;
+        tcb->rtx_numof += 1;
+        gnrc_pktbuf_hold(pkt, 1);
+
+        /* The timer is already running for an older segment */
+        if (tcb->rtx_numof > 1) {
+            return 0;
         }
+        _rto_calc(tcb);
     }
     else {
+        /* Only the oldest segment is retransmitted on timeouts */
+        if (pkt != _pkt_get_retransmit(tcb)) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not queued\n");
+            return -EINVAL;
+        }
+        gnrc_pktbuf_hold(pkt, 1);
+
         /* If this is a retransmission: Double the rto (Timer Backoff) */
         tcb->rto *= 2;
 
@@ -393,50 +474,66 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         }
     }
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
+    _rto_timer_set(tcb);
+    return 0;
+}
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+gnrc_pktsnip_t *_pkt_get_retransmit(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->rtx_numof > 0) ? tcb->rtx_queue[tcb->rtx_head] : NULL;
+}
+
+int _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (uint8_t i = 0; i < tcb->rtx_numof; i++) {
+        uint8_t idx = (tcb->rtx_head + i) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE;
+        gnrc_pktsnip_t *pkt = tcb->rtx_queue[idx];
+        uint32_t seq = _pkt_get_seq_num(pkt);
+
+        /* Only segments that were received completely are marked */
+        if (LEQ_32_BIT(left, seq) && LEQ_32_BIT(seq + _pkt_get_seg_len(pkt), right)) {
+            tcb->rtx_flags[idx] |= RTX_FLAG_SACKED;
+        }
+    }
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
+    gnrc_pktsnip_t *pkt = NULL;
     uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    bool acked = false;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_numof == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release all segments that are acknowledged completely, oldest first */
+    while ((pkt = _pkt_get_retransmit(tcb)) != NULL) {
+        seg = _pkt_get_seq_num(pkt) + _pkt_get_seg_len(pkt) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        tcb->rtx_head = (tcb->rtx_head + 1) % GNRC_TCP_RETRANSMIT_QUEUE_SIZE;
+        tcb->rtx_numof -= 1;
+        acked = true;
+    }
+    if (!acked) {
+        return 0;
+    }
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the measured segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_MEASURE;
+
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -451,6 +548,13 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Restart the retransmission timer for the remaining segments (RFC 6298, 5.2 and 5.3) */
+    xtimer_remove(&(tcb->tim_tout));
+    if (tcb->rtx_numof > 0) {
+        _rto_calc(tcb);
+        _rto_timer_set(tcb);
+    }
     return 0;
 }
 
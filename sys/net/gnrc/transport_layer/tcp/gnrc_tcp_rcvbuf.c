@@ -16,6 +16,11 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include <utlist.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -98,4 +103,128 @@ void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
     }
+    while (tcb->ooo_numof > 0) {
+        tcb->ooo_numof -= 1;
+        gnrc_pktbuf_release(tcb->ooo_queue[tcb->ooo_numof]);
+    }
+}
+
+/**
+ * @brief Copies the payload of a segment into the receive buffer.
+ *
+ * @param[in,out] tcb      TCB holding the receive buffer.
+ * @param[in]     pkt      Segment containing payload.
+ * @param[in]     offset   Number of payload bytes to skip.
+ *
+ * @returns   Number of bytes copied. Less than the remaining payload if the
+ *            receive buffer is full.
+ */
+static size_t _add_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t offset)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    size_t added = 0;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (offset < snp->size) {
+            size_t len = snp->size - offset;
+            size_t num = ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + offset, len);
+
+            added += num;
+            if (num < len) {
+                break;
+            }
+            offset = 0;
+        }
+        else {
+            offset -= snp->size;
+        }
+        snp = snp->next;
+    }
+    return added;
+}
+
+/**
+ * @brief Keeps a segment that arrived after a gap in the out-of-order queue.
+ *
+ * @param[in,out] tcb       TCB holding the out-of-order queue.
+ * @param[in]     pkt       Received segment.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ */
+static void _ooo_insert(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    uint32_t seg_end = seg_seq + _pkt_get_pay_len(pkt);
+    uint8_t pos = 0;
+
+    tcb->ooo_recent = seg_seq;
+
+    /* Find insert position, the queue is sorted by sequence number */
+    for (; pos < tcb->ooo_numof; pos++) {
+        gnrc_pktsnip_t *cur = tcb->ooo_queue[pos];
+        uint32_t seq = _pkt_get_seq_num(cur);
+
+        /* Drop segments whose payload is queued already */
+        if (LEQ_32_BIT(seq, seg_seq) && LEQ_32_BIT(seg_end, seq + _pkt_get_pay_len(cur))) {
+            return;
+        }
+        if (LSS_32_BIT(seg_seq, seq)) {
+            break;
+        }
+    }
+
+    /* If the queue is full, drop the segment farthest from rcv_nxt */
+    if (tcb->ooo_numof >= GNRC_TCP_OOO_QUEUE_SIZE) {
+        if (pos >= tcb->ooo_numof) {
+            DEBUG("gnrc_tcp_rcvbuf.c : _ooo_insert() : Out-of-order queue is full\n");
+            return;
+        }
+        tcb->ooo_numof -= 1;
+        gnrc_pktbuf_release(tcb->ooo_queue[tcb->ooo_numof]);
+    }
+
+    /* Keep the received packet itself */
+    memmove(&tcb->ooo_queue[pos + 1], &tcb->ooo_queue[pos],
+            (tcb->ooo_numof - pos) * sizeof(tcb->ooo_queue[0]));
+    tcb->ooo_queue[pos] = pkt;
+    tcb->ooo_numof += 1;
+    gnrc_pktbuf_hold(pkt, 1);
+}
+
+size_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    size_t added = 0;
+
+    /* Segment starts after a gap: keep it until the gap is filled */
+    if (LSS_32_BIT(tcb->rcv_nxt, seg_seq)) {
+        _ooo_insert(tcb, pkt, seg_seq);
+        return 0;
+    }
+
+    /* Add payload that was not received before */
+    added = _add_payload(tcb, pkt, tcb->rcv_nxt - seg_seq);
+    tcb->rcv_nxt += added;
+
+    /* Add queued segments that follow without a gap */
+    while (tcb->ooo_numof > 0) {
+        gnrc_pktsnip_t *ooo = tcb->ooo_queue[0];
+        uint32_t seq = _pkt_get_seq_num(ooo);
+        size_t num = 0;
+
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+        num = _add_payload(tcb, ooo, tcb->rcv_nxt - seq);
+        tcb->rcv_nxt += num;
+        added += num;
+
+        /* Keep the rest of the segment if the receive buffer is full */
+        if (LSS_32_BIT(tcb->rcv_nxt, seq + _pkt_get_pay_len(ooo))) {
+            break;
+        }
+        tcb->ooo_numof -= 1;
+        memmove(&tcb->ooo_queue[0], &tcb->ooo_queue[1],
+                tcb->ooo_numof * sizeof(tcb->ooo_queue[0]));
+        gnrc_pktbuf_release(ooo);
+    }
+    return added;
 }
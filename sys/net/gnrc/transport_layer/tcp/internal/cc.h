@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TCP congestion control (NewReno, see RFC 5681 and RFC 6582).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes congestion control after the connection was synchronized.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates the number of bytes that can be sent right now.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes allowed by the congestion window and the peers
+ *            receive window minus the bytes in flight.
+ */
+uint32_t _cc_get_send_wnd(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handles an acknowledgment of new data.
+ *
+ * @pre tcb->snd_una was advanced and the acknowledged segments were removed
+ *      from the retransmission queue.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+/**
+ * @brief Handles a duplicate acknowledgment, triggers fast retransmit.
+ *
+ * During fast recovery, segments in front of selectively acknowledged data are
+ * retransmitted one per duplicate acknowledgment.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handles an expired retransmission timer.
+ *
+ * @note Must be called before the oldest segment is retransmitted.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -49,6 +49,18 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_MEASURE    (1 << 4)
+#define STATUS_FAST_RECOVERY  (1 << 5)
+#define STATUS_SACK_PERMITTED (1 << 6)
+#define STATUS_TIMED_OUT      (1 << 7)
+/** @} */
+
+/**
+ * @brief Flags of segments in the retransmission queue
+ * @{
+ */
+#define RTX_FLAG_SACKED       (1 << 0)
+#define RTX_FLAG_RESENT       (1 << 1)
 /** @} */
 
 /**
@@ -31,6 +31,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum number of SACK blocks in a segment (see RFC 2018)
+ */
+#define OPTION_SACK_BLOCKS_MAX (4U)
+
+/**
+ * @brief Maximum size of the SACK option including two leading NOP options
+ */
+#define OPTION_SACK_SIZE_MAX (4U + OPTION_SACK_BLOCKS_MAX * TCP_OPTION_LENGTH_SACK_BLOCK)
+
 /**
  * @brief Helper function to build the MSS option.
  *
@@ -44,6 +54,18 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option, padded with two NOP options.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -58,6 +80,21 @@ static inline uint16_t _option_build_offset_control(uint16_t nopts, uint16_t ctl
     return (nopts << 12) | ctl;
 }
 
+/**
+ * @brief Builds the SACK option from the out-of-order queue of a TCB.
+ *
+ * The option is padded with two leading NOP options. The first block contains
+ * the most recently received segment (see RFC 2018, section 4).
+ *
+ * @param[in]  tcb   TCB holding the out-of-order queue.
+ * @param[out] opt   Buffer to write the option into.
+ * @param[in]  len   Size of @p opt.
+ *
+ * @returns   Number of bytes written into @p opt, a multiple of four.
+ *            Zero if SACK is not permitted or there is nothing to report.
+ */
+size_t _option_build_sack(const gnrc_tcp_tcb_t *tcb, uint8_t *opt, size_t len);
+
 /**
  * @brief Parses options of a given TCP header.
  *
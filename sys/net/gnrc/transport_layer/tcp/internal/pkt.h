@@ -70,6 +70,8 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
  * @param[in]     out_pkt      Pointer to paket to send.
  * @param[in]     seq_con      Sequence number consumption of the packet to send.
  * @param[in]     retransmit   Flag so mark that packet this is a retransmission.
+ *                             Does not count towards gnrc_tcp_tcb_t::retries,
+ *                             which only counts retransmission timeouts.
  *
  * @returns   Zero on success.
  *            -EINVAL if out_pkt was NULL.
@@ -98,6 +100,15 @@ int _pkt_chk_seq_num(const gnrc_tcp_tcb_t *tcb, const uint32_t seq_num, const ui
  */
 uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Extracts the sequence number of a segment.
+ *
+ * @param[in] pkt   Packet containing a TCP header.
+ *
+ * @returns   Sequence number of the segment.
+ */
+uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief Calculates a packets payload length.
  *
@@ -116,12 +127,34 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or @p retransmit is set and @p pkt is not
+ *            the oldest packet in the retransmission queue.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Get the oldest packet in the retransmission queue.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The oldest unacknowledged packet.
+ *            NULL if the retransmission queue is empty.
+ */
+gnrc_pktsnip_t *_pkt_get_retransmit(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Marks packets in the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ *
+ * @returns   Zero on success.
+ */
+int _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -63,12 +63,27 @@ void _rcvbuf_init(void);
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release allocated receive buffer and queued out-of-order segments.
  *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Adds the payload of a received segment to the receive buffer.
+ *
+ * Segments that start after a gap are kept in the out-of-order queue of @p tcb
+ * without copying. Once the gap is filled, their payload is added as well.
+ * Advances rcv_nxt accordingly.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     pkt       Received segment containing payload.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ *
+ * @returns   Number of bytes added to the receive buffer.
+ */
+size_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,166 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief returns the rank of a single hop entry, entries of the table are
+ *        ordered by descending rank
+ *
+ * @param[in] entry     the entry, must be in use
+ *
+ * @return the prefix length in bits for network prefixes
+ *         0 for default routes
+ *         -1 for host routes, which only match the exact address
+ */
+static int fib_entry_rank(const fib_entry_t *entry)
+{
+    for (size_t i = 0; i < entry->global->address_size; ++i) {
+        if (entry->global->address[i] != 0) {
+            int prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                             >> FIB_FLAG_NET_PREFIX_SHIFT;
+
+            return (prefix_len > 0) ? prefix_len : -1;
+        }
+    }
+
+    /* the address is all 0, e.g. ::/0 for IPv6 */
+    return 0;
+}
+
+/**
+ * @brief checks if the first bits of two addresses are equal
+ *
+ * @param[in] prefix    the prefix
+ * @param[in] addr      the address
+ * @param[in] bits      the number of bits to compare
+ *
+ * @return true if the first @p bits of @p prefix and @p addr are equal
+ */
+static bool fib_prefix_match(const uint8_t *prefix, const uint8_t *addr,
+                             size_t bits)
+{
+    size_t bytes = bits >> 3;
+
+    if (memcmp(prefix, addr, bytes) != 0) {
+        return false;
+    }
+    if ((bits & 0x7) == 0) {
+        return true;
+    }
+
+    return ((prefix[bytes] ^ addr[bytes]) & (0xff << (8 - (bits & 0x7)))) == 0;
+}
+
+/**
+ * @brief returns the number of used entries of a single hop table
+ */
+static size_t fib_used_entries(fib_table_t *table)
+{
+    size_t used = 0;
+
+    while ((used < table->size) && (table->data.entries[used].global != NULL)) {
+        used++;
+    }
+
+    return used;
+}
+
+/**
+ * @brief removes the given entry and closes the gap it leaves in the table
+ *
+ * @param[in] table the FIB table of the entry
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    size_t idx = entry - table->data.entries;
+    size_t used = fib_used_entries(table);
+    fib_entry_t *last = &table->data.entries[used - 1];
+
+    if (entry->global != NULL) {
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    memmove(entry, entry + 1, (used - idx - 1) * sizeof(fib_entry_t));
+
+    last->global = NULL;
+    last->global_flags = 0;
+    last->next_hop = NULL;
+    last->next_hop_flags = 0;
+
+    last->iface_id = KERNEL_PID_UNDEF;
+    last->lifetime = 0;
+
+    return 0;
+}
+
+/**
+ * @brief sets the lifetime of an entry and keeps track of the next one to
+ *        expire
+ *
+ * @param[in] table     the FIB table of the entry
+ * @param[in] entry     the entry
+ * @param[in] lifetime  the lifetime in ms
+ */
+static void fib_set_lifetime(fib_table_t *table, fib_entry_t *entry,
+                             uint32_t lifetime)
+{
+    if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
+        fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+
+        if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
+    }
+    else {
+        entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
+    }
+}
+
+/**
+ * @brief removes all expired entries once the earliest lifetime in the table
+ *        passed
+ *
+ * @param[in] table     the FIB table
+ */
+static void fib_expire(fib_table_t *table)
+{
+    if (table->next_expiry == FIB_LIFETIME_NO_EXPIRE) {
+        return;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+
+    if (now < table->next_expiry) {
+        return;
+    }
+
+    uint64_t next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    size_t i = 0;
+
+    while ((i < table->size) && (table->data.entries[i].global != NULL)) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if (entry->lifetime < now) {
+            /* the following entries move up, so i stays */
+            fib_remove(table, entry);
+        }
+        else {
+            if (entry->lifetime < next_expiry) {
+                next_expiry = entry->lifetime;
+            }
+            i++;
+        }
+    }
+
+    table->next_expiry = next_expiry;
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,13 +241,8 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
-
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    fib_entry_t *entries = table->data.entries;
+    universal_address_container_t *container;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -97,101 +252,49 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
-    }
-
-    for (size_t i = 0; i < table->size; ++i) {
-
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
+    fib_expire(table);
 
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
-        }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
-
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
+    /* an entry for the exact address shares its container */
+    container = universal_address_find(dst, dst_size);
+    if (container != NULL) {
+        for (size_t i = 0; (i < table->size) && (entries[i].global != NULL); ++i) {
+            if (entries[i].global == container) {
+                entry_arr[0] = &entries[i];
                 *entry_arr_size = 1;
                 /* we will not find a better one so we return */
                 return 1;
             }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
-                }
-                match_size = dst_size<<3;
-            }
         }
     }
 
-#if ENABLE_DEBUG
-    if (count > 0) {
-        DEBUG("[fib_find_entry] found prefix on interface %d:", entry_arr[0]->iface_id);
-        for (size_t i = 0; i < entry_arr[0]->global->address_size; i++) {
-            DEBUG(" %02x", entry_arr[0]->global->address[i]);
+    /* the first matching prefix is the longest one, default routes follow
+     * the prefixes */
+    for (size_t i = 0; (i < table->size) && (entries[i].global != NULL); ++i) {
+        int rank = fib_entry_rank(&entries[i]);
+
+        if (rank < 0) {
+            /* only host routes left */
+            break;
+        }
+        if ((entries[i].global->address_size == dst_size) &&
+            ((size_t)rank <= (dst_size << 3)) &&
+            fib_prefix_match(entries[i].global->address, dst, rank)) {
+            DEBUG("[fib_find_entry] found /%d prefix on interface %d\n",
+                  rank, entries[i].iface_id);
+            entry_arr[0] = &entries[i];
+            *entry_arr_size = 1;
+            return 0;
         }
-        DEBUG("\n");
     }
-#endif
 
-    *entry_arr_size = count;
-    return ret;
+    *entry_arr_size = 0;
+    return -EHOSTUNREACH;
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table of the entry
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,9 +304,9 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
-                         size_t next_hop_size, uint32_t next_hop_flags,
-                         uint32_t lifetime)
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry,
+                         uint8_t *next_hop, size_t next_hop_size,
+                         uint32_t next_hop_flags, uint32_t lifetime)
 {
     universal_address_container_t *container = universal_address_add(next_hop, next_hop_size);
 
@@ -214,13 +317,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     universal_address_rem(entry->next_hop);
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
-
-    if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
-        fib_lifetime_to_absolute(lifetime, &entry->lifetime);
-    }
-    else {
-        entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
-    }
+    fib_set_lifetime(table, entry, lifetime);
 
     return 0;
 }
@@ -246,60 +343,36 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
-    for (size_t i = 0; i < table->size; ++i) {
-        if (table->data.entries[i].lifetime == 0) {
-
-            table->data.entries[i].global = universal_address_add(dst, dst_size);
-
-            if (table->data.entries[i].global != NULL) {
-                table->data.entries[i].global_flags = dst_flags;
-                table->data.entries[i].next_hop = universal_address_add(next_hop, next_hop_size);
-                table->data.entries[i].next_hop_flags = next_hop_flags;
-            }
-
-            if (table->data.entries[i].next_hop != NULL) {
-                /* everything worked fine */
-                table->data.entries[i].iface_id = iface_id;
+    size_t used = fib_used_entries(table);
+    fib_entry_t entry = { .iface_id = iface_id, .global_flags = dst_flags,
+                          .next_hop_flags = next_hop_flags };
+    size_t pos = 0;
+    int rank;
 
-                if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
-                    fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
-                }
-                else {
-                    table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
-                }
-
-                return 0;
-            }
-        }
+    if (used == table->size) {
+        return -ENOMEM;
     }
 
-    return -ENOMEM;
-}
-
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
+    entry.global = universal_address_add(dst, dst_size);
+    if (entry.global == NULL) {
+        return -ENOMEM;
     }
 
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
+    entry.next_hop = universal_address_add(next_hop, next_hop_size);
+    if (entry.next_hop == NULL) {
+        universal_address_rem(entry.global);
+        return -ENOMEM;
     }
 
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
+    /* keep the table ordered, so lookups can stop at the first match */
+    rank = fib_entry_rank(&entry);
+    while ((pos < used) && (fib_entry_rank(&table->data.entries[pos]) >= rank)) {
+        pos++;
+    }
+    memmove(&table->data.entries[pos + 1], &table->data.entries[pos],
+            (used - pos) * sizeof(fib_entry_t));
+    table->data.entries[pos] = entry;
+    fib_set_lifetime(table, &table->data.entries[pos], lifetime);
 
     return 0;
 }
@@ -403,7 +476,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +506,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +530,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -474,10 +547,16 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_flush]\n");
 
-    for (size_t i = 0; i < table->size; ++i) {
+    size_t i = 0;
+
+    while ((i < table->size) && (table->data.entries[i].global != NULL)) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            /* the following entries move up, so i stays */
+            fib_remove(table, &table->data.entries[i]);
+        }
+        else {
+            i++;
         }
     }
 
@@ -587,6 +666,7 @@ void fib_init(fib_table_t *table)
     }
 
     table->notify_rp_pos = 0;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
         memset(table->data.source_routes->headers, 0,
@@ -612,6 +692,7 @@ void fib_deinit(fib_table_t *table)
     }
 
     table->notify_rp_pos = 0;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
         memset(table->data.source_routes->headers, 0,
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "net/sock/async_event.h"
+
+static void _handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    unsigned state = irq_disable();
+    sock_async_flags_t flags = event->flags;
+
+    event->flags = 0;
+    irq_restore(state);
+    if (flags != 0) {
+        event->handler.generic(event->sock, flags, event->handler_arg);
+    }
+}
+
+/* called by the stack or the sending thread */
+static void _cb(void *sock, sock_async_flags_t flags, void *arg)
+{
+    sock_event_t *event = arg;
+    unsigned state = irq_disable();
+
+    event->sock = sock;
+    event->flags |= flags;
+    irq_restore(state);
+    /* does nothing if the event is still queued */
+    event_post(event->queue, &event->super);
+}
+
+static void _init(sock_event_t *event, event_queue_t *queue, void *sock,
+                  void *handler_arg)
+{
+    assert((event != NULL) && (queue != NULL));
+    event->super.list_node.next = NULL;
+    event->super.handler = _handler;
+    event->queue = queue;
+    event->sock = sock;
+    event->handler_arg = handler_arg;
+    event->flags = 0;
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    _cb(sock, flags, arg);
+}
+
+void sock_ip_event_init(sock_ip_t *sock, sock_event_t *event,
+                        event_queue_t *queue, sock_ip_cb_t handler,
+                        void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, queue, sock, handler_arg);
+    event->handler.ip = handler;
+    sock_ip_set_cb(sock, _ip_cb, event);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    _cb(sock, flags, arg);
+}
+
+void sock_udp_event_init(sock_udp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_udp_cb_t handler,
+                         void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, queue, sock, handler_arg);
+    event->handler.udp = handler;
+    sock_udp_set_cb(sock, _udp_cb, event);
+}
+#endif
+
+void sock_event_clear(sock_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    event->flags = 0;
+    irq_restore(state);
+    event_cancel(event->queue, &event->super);
+}
+
+/** @} */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    posix_poll  POSIX poll and select
+ * @ingroup     posix
+ * @brief       Wait for readiness of several file descriptors in one thread
+ *
+ * `poll()` and `select()` work on all @ref sys_vfs file descriptors. Files
+ * whose driver does not implement vfs_file_ops::poll are always ready.
+ * @ref posix_sockets implement it for datagram sockets with the
+ * `sock_async` module (currently only provided by @ref net_gnrc_sock), so a
+ * single thread can serve many sockets. Stream and raw sockets report
+ * `POLLNVAL`.
+ *
+ * The waiting thread is woken up with thread flags, see
+ * @ref VFS_POLL_THREAD_FLAG.
+ *
+ * `select()` is declared by the `<sys/select.h>` of the C library.
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specifications Issue 7, poll()
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief   poll() definitions
+ */
+#ifndef POLL_H
+#define POLL_H
+
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags for pollfd::events and pollfd::revents
+ * @{
+ */
+#define POLLIN      VFS_POLLIN  /**< data other than high-priority may be read */
+#define POLLPRI     (0x0002)    /**< high-priority data may be read (unused) */
+#define POLLOUT     VFS_POLLOUT /**< data may be written */
+#define POLLERR     VFS_POLLERR /**< an error occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< device has been disconnected (revents only) */
+#define POLLNVAL    (0x0020)    /**< invalid fd or fd can not be polled
+                                 *   (revents only) */
+/** @} */
+
+/**
+ * @brief   Type for the number of entries in a pollfd array
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to poll
+ */
+struct pollfd {
+    int fd;                     /**< file descriptor, ignored if negative */
+    short events;               /**< requested events */
+    short revents;              /**< returned events */
+};
+
+/**
+ * @brief   Waits until one of a set of file descriptors is ready
+ *
+ * @param[in,out] fds   file descriptors to poll
+ * @param[in] nfds      number of entries in @p fds
+ * @param[in] timeout   timeout in milliseconds, -1 to wait forever, 0 to
+ *                      return immediately. Timeouts are capped to
+ *                      `UINT32_MAX` microseconds.
+ *
+ * @return  number of entries in @p fds with non-zero pollfd::revents
+ * @return  0 if @p timeout expired
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+/** @} */
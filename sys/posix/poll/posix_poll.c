@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   poll() and select() on top of vfs_poll()
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/select.h>
+
+#include "poll.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "timex.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _WAIT_FLAGS     (VFS_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT)
+
+/* queries all entries of fds and registers waiter with them, returns the
+ * number of ready entries */
+static int _poll_all(struct pollfd fds[], nfds_t nfds, kernel_pid_t waiter)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        int res;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        res = vfs_poll(fds[i].fd, fds[i].events & (POLLIN | POLLOUT), waiter);
+        if (res < 0) {
+            DEBUG("poll: unable to poll fd %d: %d\n", fds[i].fd, res);
+            fds[i].revents = POLLNVAL;
+        }
+        else {
+            fds[i].revents = res;
+        }
+        if (fds[i].revents != 0) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+static void _unregister(struct pollfd fds[], nfds_t nfds)
+{
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd >= 0) {
+            vfs_poll(fds[i].fd, 0, KERNEL_PID_UNDEF);
+        }
+    }
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    xtimer_t timer = { .callback = NULL };
+    int ready;
+
+    if (timeout == 0) {
+        return _poll_all(fds, nfds, KERNEL_PID_UNDEF);
+    }
+    thread_flags_clear(_WAIT_FLAGS);
+    if (timeout > 0) {
+        uint64_t usec = (uint64_t)timeout * US_PER_MS;
+
+        xtimer_set_timeout_flag(&timer,
+                                (usec > UINT32_MAX) ? UINT32_MAX : usec);
+    }
+    /* every wake-up only tells that some file may have become ready, so all
+     * of them are checked again */
+    while ((ready = _poll_all(fds, nfds, thread_getpid())) == 0) {
+        if (thread_flags_wait_any(_WAIT_FLAGS) & THREAD_FLAG_TIMEOUT) {
+            ready = _poll_all(fds, nfds, KERNEL_PID_UNDEF);
+            break;
+        }
+    }
+    _unregister(fds, nfds);
+    if (timer.callback != NULL) {
+        xtimer_remove(&timer);
+    }
+    thread_flags_clear(_WAIT_FLAGS);
+    return ready;
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    struct pollfd fds[VFS_MAX_OPEN_FILES];
+    nfds_t num = 0;
+    int res, ready = 0;
+
+    if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+
+        if ((readfds != NULL) && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if ((writefds != NULL) && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        if ((events == 0) && ((errorfds == NULL) || !FD_ISSET(fd, errorfds))) {
+            continue;
+        }
+        if (num >= VFS_MAX_OPEN_FILES) {
+            errno = EBADF;
+            return -1;
+        }
+        fds[num].fd = fd;
+        fds[num].events = events;
+        num++;
+    }
+    if (timeout != NULL) {
+        uint64_t msec = ((uint64_t)timeout->tv_sec * MS_PER_SEC) +
+                        (timeout->tv_usec / US_PER_MS);
+
+        res = poll(fds, num, (msec > INT_MAX) ? INT_MAX : (int)msec);
+    }
+    else {
+        res = poll(fds, num, -1);
+    }
+    for (nfds_t i = 0; i < num; i++) {
+        if (fds[i].revents & POLLNVAL) {
+            errno = EBADF;
+            return -1;
+        }
+    }
+    if (readfds != NULL) {
+        FD_ZERO(readfds);
+    }
+    if (writefds != NULL) {
+        FD_ZERO(writefds);
+    }
+    if (errorfds != NULL) {
+        FD_ZERO(errorfds);
+    }
+    for (nfds_t i = 0; (res > 0) && (i < num); i++) {
+        if ((readfds != NULL) && (fds[i].revents & POLLIN)) {
+            FD_SET(fds[i].fd, readfds);
+            ready++;
+        }
+        if ((writefds != NULL) && (fds[i].revents & POLLOUT)) {
+            FD_SET(fds[i].fd, writefds);
+            ready++;
+        }
+        if ((errorfds != NULL) && (fds[i].revents & POLLERR)) {
+            FD_SET(fds[i].fd, errorfds);
+            ready++;
+        }
+    }
+    return ready;
+}
+
+/** @} */
@@ -35,6 +35,16 @@
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
+/* poll() is only supported for UDP sockets */
+#if defined(MODULE_POSIX_POLL) && defined(MODULE_SOCK_UDP)
+#define _SOCKET_POLL
+#endif
+
+#ifdef _SOCKET_POLL
+#include "net/sock/async.h"
+#include "thread.h"
+#include "thread_flags.h"
+#endif
 
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
@@ -79,6 +89,15 @@ typedef struct {
     unsigned queue_array_len;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
+#ifdef _SOCKET_POLL
+    kernel_pid_t waiter;        /* thread to notify on receive */
+    struct {
+        void *data;             /* first chunk of the message */
+        void *ctx;              /* buffer context, NULL if nothing received */
+        ssize_t len;            /* length of first chunk */
+        sock_udp_ep_t remote;   /* sender of the message */
+    } peek;                     /* message received by socket_poll() */
+#endif
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
@@ -99,6 +118,8 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
 static ssize_t socket_sendto(socket_t *s, const void *buffer, size_t length,
                              int flags, const struct sockaddr *address,
                              socklen_t address_len);
+static int _bind_connect(socket_t *s, const struct sockaddr *address,
+                         socklen_t address_len);
 
 static socket_t *_get_free_socket(void)
 {
@@ -244,6 +265,65 @@ static int _sockaddr_to_ep(const struct sockaddr *address, socklen_t address_len
     return 0;
 }
 
+#ifdef _SOCKET_POLL
+static void _async_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    socket_t *s = arg;
+    kernel_pid_t waiter = s->waiter;
+
+    (void)sock;
+    (void)flags;
+    if (waiter != KERNEL_PID_UNDEF) {
+        thread_t *thread = (thread_t *)thread_get(waiter);
+
+        if (thread != NULL) {
+            thread_flags_set(thread, VFS_POLL_THREAD_FLAG);
+        }
+    }
+}
+
+/* returns 1 if a message is waiting, 0 if not, and < 0 on error */
+static int _peek(socket_t *s)
+{
+    ssize_t res;
+
+    if (s->peek.ctx != NULL) {
+        return 1;
+    }
+    res = sock_udp_recv_buf(&s->sock->udp, &s->peek.data, &s->peek.ctx, 0,
+                            &s->peek.remote);
+    if (res > 0) {
+        s->peek.len = res;
+        return 1;
+    }
+    /* a message from a wrong remote was dropped already */
+    return ((res == 0) || (res == -EAGAIN) || (res == -EPROTO)) ? 0 : res;
+}
+
+/* copies the message received by _peek() into buffer */
+static ssize_t _recv_peeked(socket_t *s, void *buffer, size_t length,
+                            struct _sock_tl_ep *ep)
+{
+    uint8_t *ptr = buffer;
+    void *data = s->peek.data;
+    ssize_t len = s->peek.len, res = 0;
+
+    memcpy(ep, &s->peek.remote, sizeof(*ep));
+    while (len > 0) {
+        if ((res >= 0) && ((size_t)(res + len) <= length)) {
+            memcpy(ptr + res, data, len);
+            res += len;
+        }
+        else {
+            res = -ENOBUFS;
+        }
+        /* releases the message after the last chunk */
+        len = sock_udp_recv_buf(&s->sock->udp, &data, &s->peek.ctx, 0, NULL);
+    }
+    return res;
+}
+#endif
+
 static int socket_close(vfs_file_t *filp)
 {
     socket_t *s = filp->private_data.ptr;
@@ -256,6 +336,13 @@ static int socket_close(vfs_file_t *filp)
         switch (s->type) {
 #ifdef MODULE_SOCK_UDP
             case SOCK_DGRAM:
+#ifdef _SOCKET_POLL
+                s->waiter = KERNEL_PID_UNDEF;
+                while (s->peek.ctx != NULL) {
+                    sock_udp_recv_buf(&s->sock->udp, &s->peek.data,
+                                      &s->peek.ctx, 0, NULL);
+                }
+#endif
                 sock_udp_close(&s->sock->udp);
                 break;
 #endif
@@ -316,6 +403,40 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+#ifdef _SOCKET_POLL
+static int socket_poll(vfs_file_t *filp, unsigned events, kernel_pid_t waiter)
+{
+    socket_t *s = filp->private_data.ptr;
+    /* sending on a datagram socket never blocks */
+    unsigned revents = events & VFS_POLLOUT;
+    int res;
+
+    if (s->type != SOCK_DGRAM) {
+        return -EOPNOTSUPP;
+    }
+    if (s->sock == NULL) {
+        /* an unbound socket can not receive anything */
+        if (!s->bound) {
+            return revents;
+        }
+        if (_bind_connect(s, NULL, 0) < 0) {
+            return VFS_POLLERR;
+        }
+    }
+    /* register before checking so no message is missed in between */
+    s->waiter = waiter;
+    if (events & VFS_POLLIN) {
+        if ((res = _peek(s)) < 0) {
+            return VFS_POLLERR;
+        }
+        else if (res > 0) {
+            revents |= VFS_POLLIN;
+        }
+    }
+    return revents;
+}
+#endif
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
     .fcntl = NULL,          /* TODO: provide when needed */
@@ -323,6 +444,9 @@ static const vfs_file_ops_t socket_ops = {
     .lseek = socket_lseek,
     .read = socket_read,
     .write = socket_write,
+#ifdef _SOCKET_POLL
+    .poll = socket_poll,
+#endif
 };
 
 int socket(int domain, int type, int protocol)
@@ -364,6 +488,10 @@ int socket(int domain, int type, int protocol)
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
+#ifdef _SOCKET_POLL
+            s->waiter = KERNEL_PID_UNDEF;
+            s->peek.ctx = NULL;
+#endif
 #ifdef MODULE_SOCK_TCP
             if (type == SOCK_STREAM)  {
                 s->queue_array = NULL;
@@ -574,6 +702,11 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         case SOCK_DGRAM:
             /* TODO apply flags if possible */
             res = sock_udp_create(&sock->udp, local, remote, 0);
+#ifdef _SOCKET_POLL
+            if (res == 0) {
+                sock_udp_set_cb(&sock->udp, _async_cb, s);
+            }
+#endif
             break;
 #endif
         default:
@@ -852,6 +985,12 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
 #endif
 #ifdef MODULE_SOCK_UDP
         case SOCK_DGRAM:
+#ifdef _SOCKET_POLL
+            if (s->peek.ctx != NULL) {
+                res = _recv_peeked(s, buffer, length, &ep);
+                break;
+            }
+#endif
             res = sock_udp_recv(&s->sock->udp, buffer, length, recv_timeout,
                                 &ep);
             break;
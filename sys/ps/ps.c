@@ -46,6 +46,33 @@ static const char *state_names[] = {
     [STATUS_MBOX_BLOCKED] = "bl mbox",
 };
 
+#ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @brief Prints the wakeup latency histograms of all threads.
+ */
+static void _print_latency(void)
+{
+    printf("\n\twakeup latency [ticks]\n\tpid |");
+    for (unsigned b = 0; b < SCHEDSTAT_LATENCY_BUCKETS; b++) {
+        /* bucket b > 0 starts at 2^(b-1) */
+        printf(" %5lu%s", b ? (1UL << (b - 1)) : 0UL,
+               (b == SCHEDSTAT_LATENCY_BUCKETS - 1) ? "+" : "");
+    }
+    puts("");
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] == NULL) {
+            continue;
+        }
+        printf("\t%3" PRIkernel_pid " |", i);
+        for (unsigned b = 0; b < SCHEDSTAT_LATENCY_BUCKETS; b++) {
+            printf(" %5u", (unsigned)sched_pidlist[i].latency[b]);
+        }
+        puts("");
+    }
+}
+#endif /* MODULE_SCHEDSTATISTICS */
+
 /**
  * @brief Prints a list of running threads including stack usage to stdout.
  */
@@ -65,7 +92,7 @@ void ps(void)
            "| stack  ( used) | base addr  | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime  | switches"
+           "| runtime  | switches  | preempt  | max burst | irq off"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -114,6 +141,7 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+            unsigned preemptions = sched_pidlist[i].preemptions;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -124,7 +152,7 @@ void ps(void)
                    " | %6i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %2d.%03d%% |  %8u"
+                   " | %2d.%03d%% |  %8u |  %8u | %9" PRIu32 " | %9" PRIu32
 #endif
                    "\n",
                    p->pid,
@@ -136,7 +164,8 @@ void ps(void)
                    , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_major, runtime_minor, switches
+                   , runtime_major, runtime_minor, switches, preemptions,
+                   sched_pidlist[i].max_burst, sched_pidlist[i].irq_off_ticks
 #endif
                   );
         }
@@ -153,4 +182,8 @@ void ps(void)
     printf("\tTotal used size: %u\n", sizes.used);
 #   endif
 #endif
+
+#ifdef MODULE_SCHEDSTATISTICS
+    _print_latency();
+#endif
 }
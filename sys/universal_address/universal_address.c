@@ -46,6 +46,17 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+/**
+ * @brief Number of hash buckets used to look up entries by address
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_BUCKETS
+#define UNIVERSAL_ADDRESS_HASH_BUCKETS      (16U)
+#endif
+
+#if (UNIVERSAL_ADDRESS_HASH_BUCKETS & (UNIVERSAL_ADDRESS_HASH_BUCKETS - 1)) != 0
+#error "UNIVERSAL_ADDRESS_HASH_BUCKETS must be a power of two"
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -61,6 +72,41 @@ static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_M
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief Entries with an address (used or not), hashed by the address.
+ *        Each bucket and chain link holds the index of an entry plus 1, or 0
+ *        at the end of a chain.
+ */
+static uint16_t universal_address_buckets[UNIVERSAL_ADDRESS_HASH_BUCKETS];
+static uint16_t universal_address_next[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+static inline uint16_t *universal_address_bucket(const uint8_t *addr, size_t addr_size)
+{
+    unsigned hash = addr_size;
+
+    for (size_t i = 0; i < addr_size; ++i) {
+        hash = (hash * 31) ^ addr[i];
+    }
+    hash ^= hash >> 8;
+    return &universal_address_buckets[hash & (UNIVERSAL_ADDRESS_HASH_BUCKETS - 1)];
+}
+
+/**
+ * @brief removes the entry with the given index from its hash chain
+ */
+static void universal_address_unlink(size_t idx)
+{
+    universal_address_container_t *entry = &universal_address_table[idx];
+    uint16_t *link = universal_address_bucket(entry->address, entry->address_size);
+
+    while ((*link != 0) && (*link != (idx + 1))) {
+        link = &universal_address_next[*link - 1];
+    }
+    if (*link != 0) {
+        *link = universal_address_next[idx];
+    }
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,15 +118,16 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    uint16_t idx = *universal_address_bucket(addr, addr_size);
+
+    while (idx != 0) {
+        universal_address_container_t *entry = &universal_address_table[idx - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
         }
+        idx = universal_address_next[idx - 1];
     }
 
     return NULL;
@@ -124,6 +171,14 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+        size_t idx = pEntry - universal_address_table;
+        uint16_t *bucket = universal_address_bucket(addr, addr_size);
+
+        /* the former address is not found under its hash anymore */
+        if (pEntry->address_size != 0) {
+            universal_address_unlink(idx);
+        }
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -136,6 +191,8 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+        universal_address_next[idx] = *bucket;
+        *bucket = idx + 1;
     }
 
     pEntry->use_count++;
@@ -150,6 +207,19 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
     return pEntry;
 }
 
+universal_address_container_t *universal_address_find(uint8_t *addr, size_t addr_size)
+{
+    mutex_lock(&mtx_access);
+    universal_address_container_t *pEntry = universal_address_find_entry(addr, addr_size);
+
+    if ((pEntry != NULL) && (pEntry->use_count == 0)) {
+        pEntry = NULL;
+    }
+
+    mutex_unlock(&mtx_access);
+    return pEntry;
+}
+
 void universal_address_rem(universal_address_container_t *entry)
 {
     mutex_lock(&mtx_access);
@@ -308,8 +378,11 @@ void universal_address_init(void)
         universal_address_table[i].use_count = 0;
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
+        universal_address_next[i] = 0;
     }
 
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
+
     mutex_unlock(&mtx_access);
 }
 
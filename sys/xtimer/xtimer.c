@@ -156,6 +156,13 @@ void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t
     _xtimer_set(timer, offset);
 }
 
+void _xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset, uint32_t slack,
+                          msg_t *msg, kernel_pid_t target_pid)
+{
+    _setup_msg(timer, msg, target_pid);
+    _xtimer_set_slack(timer, offset, slack);
+}
+
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid)
 {
     _setup_msg(timer, msg, target_pid);
@@ -238,11 +245,7 @@ static void _mutex_timeout(void *arg)
     mutex_thread_t *mt = (mutex_thread_t *)arg;
 
     mt->timeout = 1;
-    list_node_t *node = list_remove(&mt->mutex->queue,
-                                    (list_node_t *)&mt->thread->rq_entry);
-    if ((node != NULL) && (mt->mutex->queue.next == NULL)) {
-        mt->mutex->queue.next = MUTEX_LOCKED;
-    }
+    _mutex_remove_waiter(mt->mutex, mt->thread->pid);
     sched_set_status(mt->thread, STATUS_PENDING);
     thread_yield_higher();
 }
@@ -55,12 +55,52 @@ static void _timer_callback(void);
 static void _periph_timer_callback(void *arg, int chan);
 
 static inline int _this_high_period(uint32_t target);
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack);
+
+#ifdef MODULE_XTIMER_COALESCE
+static xtimer_coalesce_stats_t _stats;
+/* time the low-level timer was last computed for by _list_target() */
+static uint32_t _wakeup;
+#endif
 
 static inline int _is_set(xtimer_t *timer)
 {
     return (timer->target || timer->long_target);
 }
 
+/**
+ * @brief get the low-level timer target for the current timer list
+ *
+ * Without xtimer_coalesce, this is the target of the list head. Otherwise,
+ * the latest time at which the low-level timer can fire without exceeding any
+ * listed timer's slack is used, so all timers whose windows overlap that time
+ * fire in a single callback sweep. That time is remembered in `_wakeup`.
+ */
+static inline uint32_t _list_target(void)
+{
+#ifdef MODULE_XTIMER_COALESCE
+    uint32_t target = timer_list_head->target;
+    /* don't wait past the end of the current period */
+    uint32_t deadline = (target | _xtimer_lltimer_mask(0xFFFFFFFF)) -
+                        XTIMER_ISR_BACKOFF;
+
+    for (xtimer_t *timer = timer_list_head;
+         timer && (timer->target <= deadline); timer = timer->next) {
+        uint32_t timer_deadline = timer->target + timer->slack;
+        if ((timer_deadline >= timer->target) && (timer_deadline < deadline)) {
+            deadline = timer_deadline;
+        }
+    }
+    if (deadline > target) {
+        target = deadline;
+    }
+    _wakeup = target;
+    return target - XTIMER_OVERHEAD;
+#else
+    return timer_list_head->target - XTIMER_OVERHEAD;
+#endif
+}
+
 static inline void xtimer_spin_until(uint32_t target) {
 #if XTIMER_MASK
     target = _xtimer_lltimer_mask(target);
@@ -121,6 +161,9 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         if (timer->target < offset) {
             timer->long_target++;
         }
+#ifdef MODULE_XTIMER_COALESCE
+        timer->slack = 0;
+#endif
 
         _add_timer_to_long_list(&long_list_head, timer);
         irq_restore(state);
@@ -130,6 +173,11 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _xtimer_set_slack(timer, offset, 0);
+}
+
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -146,7 +194,7 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target, slack);
     }
 }
 
@@ -172,6 +220,11 @@ static inline void _lltimer_set(uint32_t target)
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    return _set_absolute(timer, target, 0);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
@@ -196,6 +249,11 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     if (target < now) {
         timer->long_target++;
     }
+#ifdef MODULE_XTIMER_COALESCE
+    timer->slack = slack;
+#else
+    (void)slack;
+#endif
 
     if ( (timer->long_target > _long_cnt) || !_this_high_period(target) ) {
         DEBUG("xtimer_set_absolute(): the timer doesn't fit into the low-level timer's mask.\n");
@@ -210,10 +268,26 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
             _add_timer_to_list(&timer_list_head, timer);
 
+#ifdef MODULE_XTIMER_COALESCE
+            uint32_t deadline = target + slack;
+
+            if ((timer_list_head == timer) && !timer->next) {
+                DEBUG("timer_set_absolute(): timer is only list entry. updating lltimer.\n");
+                _lltimer_set(_list_target());
+            }
+            else if ((deadline >= target) && (deadline < _wakeup)) {
+                /* all timers up to the wakeup still fire in the same sweep,
+                 * so the new one can only make it earlier */
+                DEBUG("timer_set_absolute(): timer shortens sweep. updating lltimer.\n");
+                _wakeup = deadline;
+                _lltimer_set(deadline - XTIMER_OVERHEAD);
+            }
+#else
             if (timer_list_head == timer) {
                 DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
-                _lltimer_set(target - XTIMER_OVERHEAD);
+                _lltimer_set(_list_target());
             }
+#endif
         }
     }
 
@@ -264,7 +338,7 @@ static void _remove(xtimer_t *timer)
         timer_list_head = timer->next;
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = _list_target();
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -280,6 +354,15 @@ static void _remove(xtimer_t *timer)
     }
 }
 
+#ifdef MODULE_XTIMER_COALESCE
+void xtimer_coalesce_stats(xtimer_coalesce_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+#endif
+
 void xtimer_remove(xtimer_t *timer)
 {
     int state = irq_disable();
@@ -465,6 +548,10 @@ static void _timer_callback(void)
         reference = _xtimer_lltimer_now();
     }
 
+#ifdef MODULE_XTIMER_COALESCE
+    unsigned fired = 0;
+#endif
+
 overflow:
     /* check if next timers are close to expiring */
     while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
@@ -483,6 +570,12 @@ overflow:
 
         /* fire timer */
         _shoot(timer);
+#ifdef MODULE_XTIMER_COALESCE
+        _stats.fired++;
+        if (!fired++) {
+            _stats.sweeps++;
+        }
+#endif
     }
 
     /* possibly executing all callbacks took enough
@@ -499,7 +592,7 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = _list_target();
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF)) {
@@ -0,0 +1,667 @@
+/**
+ * Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+ * Copyright (C) 2016 Eistec AB
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ *
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timing wheel backend
+ *
+ * This file is a drop-in replacement for xtimer_core.c, selected by the
+ * `xtimer_wheel` pseudo module.
+ *
+ * Timers are kept in @ref XTIMER_WHEEL_LEVELS levels of
+ * 2^@ref XTIMER_WHEEL_BITS buckets each. A timer is stored on the lowest level
+ * on which its (64bit) target and the wheel's reference time `_wheel_time`
+ * share all more significant bucket indices, so the bucket a timer lives in
+ * is a pure function of its target and `_wheel_time`. This allows setting a
+ * timer by pushing it onto its bucket and removing it by walking only that
+ * single bucket. An occupancy bitmap per level finds the earliest non-empty
+ * bucket without scanning.
+ *
+ * Only timers expiring within the current level 0 bucket (2^@ref
+ * XTIMER_WHEEL_SHIFT ticks) are kept in a sorted "due" list, which the
+ * low-level timer is programmed from. Whenever the time reaches the start of
+ * the earliest occupied bucket, its timers are cascaded to lower levels (or
+ * the due list). Timers too far in the future for the wheel are kept in an
+ * unsorted list that is revisited whenever the top level wraps.
+ *
+ * @author Kaspar Schleiser <kaspar@schleiser.de>
+ * @author Joakim Nohlgård <joakim.nohlgard@eistec.se>
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_SLOTS         (1U << XTIMER_WHEEL_BITS)
+#define WHEEL_SLOT_MASK     (WHEEL_SLOTS - 1)
+#define WHEEL_FAR_SHIFT     (XTIMER_WHEEL_SHIFT + \
+                             (XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_BITS))
+
+/* buckets starting closer than this are cascaded right away, so the low-level
+ * timer is never programmed for a bucket start that may already have passed */
+#define WHEEL_LOOKAHEAD     (XTIMER_ISR_BACKOFF + XTIMER_OVERHEAD)
+
+#if (XTIMER_WHEEL_BITS > 5)
+#error "XTIMER_WHEEL_BITS must not exceed 5 (one 32bit bitmap per level)"
+#endif
+
+#if (WHEEL_FAR_SHIFT >= 64)
+#error "XTIMER_WHEEL_SHIFT + XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_BITS must be < 64"
+#endif
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/* set if the low-level timer is currently armed for the end of the period */
+static int _period_end_armed = 0;
+/* time the low-level timer was last programmed for, 0 for the period end */
+static uint64_t _wakeup = 0;
+
+static uint64_t _wheel_time = 0;
+static xtimer_t *_due_list_head = NULL;
+static xtimer_t *_far_list_head = NULL;
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t _wheel_bitmap[XTIMER_WHEEL_LEVELS];
+
+static inline void xtimer_spin_until(uint32_t value);
+static void _add(xtimer_t *timer);
+static void _remove(xtimer_t *timer);
+static void _update_lltimer(void);
+static void _shoot(xtimer_t *timer);
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack);
+
+#ifdef MODULE_XTIMER_COALESCE
+static xtimer_coalesce_stats_t _stats;
+#endif
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _target64(const xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline uint64_t _period_base(void)
+{
+#if XTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _xtimer_high_cnt;
+#else
+    return ((uint64_t)_long_cnt << 32);
+#endif
+}
+
+static inline uint64_t _period_len(void)
+{
+    return (uint64_t)_xtimer_lltimer_mask(0xFFFFFFFF) + 1;
+}
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _period_end_armed = 1;
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(0xFFFFFFFF));
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief   Get the list a timer with the given target has to be stored in
+ *
+ * @param[in]  target   64bit absolute target time
+ * @param[out] level    level of the returned bucket, XTIMER_WHEEL_LEVELS for
+ *                      the due and far lists
+ * @param[out] slot     index of the returned bucket within @p level
+ */
+static xtimer_t **_bucket(uint64_t target, unsigned *level, unsigned *slot)
+{
+    uint64_t diff = (target >> XTIMER_WHEEL_SHIFT) ^
+                    (_wheel_time >> XTIMER_WHEEL_SHIFT);
+
+    *level = XTIMER_WHEEL_LEVELS;
+    if ((target < _wheel_time) || !diff) {
+        return &_due_list_head;
+    }
+
+    unsigned lvl = 0;
+    while (diff >> XTIMER_WHEEL_BITS) {
+        diff >>= XTIMER_WHEEL_BITS;
+        if (++lvl == XTIMER_WHEEL_LEVELS) {
+            return &_far_list_head;
+        }
+    }
+
+    *level = lvl;
+    *slot = (target >> (XTIMER_WHEEL_SHIFT + lvl * XTIMER_WHEEL_BITS)) &
+            WHEEL_SLOT_MASK;
+    return &_wheel[lvl][*slot];
+}
+
+static void _add(xtimer_t *timer)
+{
+    unsigned level, slot;
+    uint64_t target = _target64(timer);
+    xtimer_t **list_head = _bucket(target, &level, &slot);
+
+    if (list_head == &_due_list_head) {
+        /* the due list is the only sorted one */
+        while (*list_head && (_target64(*list_head) <= target)) {
+            list_head = &((*list_head)->next);
+        }
+    }
+    else if (level < XTIMER_WHEEL_LEVELS) {
+        _wheel_bitmap[level] |= (1UL << slot);
+    }
+
+    timer->next = *list_head;
+    *list_head = timer;
+}
+
+static void _remove(xtimer_t *timer)
+{
+    unsigned level, slot;
+    xtimer_t **list_head = _bucket(_target64(timer), &level, &slot);
+    xtimer_t **pos = list_head;
+    int was_first = (list_head == &_due_list_head) && (*list_head == timer);
+
+    while (*pos) {
+        if (*pos == timer) {
+            *pos = timer->next;
+            break;
+        }
+        pos = &((*pos)->next);
+    }
+
+    if ((level < XTIMER_WHEEL_LEVELS) && !*list_head) {
+        _wheel_bitmap[level] &= ~(1UL << slot);
+    }
+
+    if (was_first) {
+        _update_lltimer();
+    }
+}
+
+/**
+ * @brief   Get the start time of the earliest occupied bucket
+ *
+ * @param[out] level    level of that bucket (XTIMER_WHEEL_LEVELS for the far
+ *                      list)
+ *
+ * @return  0 if neither the wheel nor the far list hold any timers
+ */
+static uint64_t _next_bucket(unsigned *level)
+{
+    for (unsigned lvl = 0; lvl < XTIMER_WHEEL_LEVELS; lvl++) {
+        if (_wheel_bitmap[lvl]) {
+            unsigned shift = XTIMER_WHEEL_SHIFT + lvl * XTIMER_WHEEL_BITS;
+            uint64_t slot = bitarithm_lsb(_wheel_bitmap[lvl]);
+            *level = lvl;
+            return (((_wheel_time >> shift) & ~((uint64_t)WHEEL_SLOT_MASK))
+                    | slot) << shift;
+        }
+    }
+
+    *level = XTIMER_WHEEL_LEVELS;
+    if (_far_list_head) {
+        return ((_wheel_time >> WHEEL_FAR_SHIFT) + 1) << WHEEL_FAR_SHIFT;
+    }
+    return 0;
+}
+
+/**
+ * @brief   Advance the wheel to shortly after @p now, cascading all buckets
+ *          that start before
+ */
+static void _advance(uint64_t now)
+{
+    now += WHEEL_LOOKAHEAD;
+
+    unsigned level;
+    uint64_t start;
+
+    while ((start = _next_bucket(&level)) && (start <= now)) {
+        xtimer_t *timer;
+
+        if (level < XTIMER_WHEEL_LEVELS) {
+            unsigned slot = (start >> (XTIMER_WHEEL_SHIFT +
+                                       level * XTIMER_WHEEL_BITS)) &
+                            WHEEL_SLOT_MASK;
+            timer = _wheel[level][slot];
+            _wheel[level][slot] = NULL;
+            _wheel_bitmap[level] &= ~(1UL << slot);
+        }
+        else {
+            timer = _far_list_head;
+            _far_list_head = NULL;
+        }
+
+        _wheel_time = start;
+        while (timer) {
+            xtimer_t *next = timer->next;
+            _add(timer);
+            timer = next;
+        }
+    }
+
+    /* no bucket starts before @p now anymore, so moving the reference time forward
+     * keeps every stored timer in its bucket */
+    if (now > _wheel_time) {
+        _wheel_time = now;
+    }
+}
+
+/**
+ * @brief   Get the time of the next event the low-level timer has to fire for
+ *
+ * @return  0 if there are no timers
+ */
+static uint64_t _next_event(void)
+{
+    unsigned level;
+
+    if (_due_list_head) {
+        return _target64(_due_list_head);
+    }
+    return _next_bucket(&level);
+}
+
+#ifdef MODULE_XTIMER_COALESCE
+/**
+ * @brief   Get the earliest deadline (target + slack) of the due timers that
+ *          start no later than it
+ */
+static uint64_t _due_deadline(void)
+{
+    uint64_t deadline = UINT64_MAX;
+
+    for (xtimer_t *timer = _due_list_head;
+         timer && (_target64(timer) <= deadline); timer = timer->next) {
+        uint64_t timer_deadline = _target64(timer) + timer->slack;
+        if (timer_deadline < deadline) {
+            deadline = timer_deadline;
+        }
+    }
+    return deadline;
+}
+#endif
+
+/**
+ * @brief   Get the time the low-level timer has to fire at next
+ *
+ * Without xtimer_coalesce, this is the next event. Otherwise, the latest time
+ * at which the low-level timer can fire without exceeding any due timer's
+ * slack is used, so all timers whose windows overlap that time fire in a
+ * single callback sweep. Buckets starting before that time are cascaded
+ * early, so their timers join the sweep as well.
+ */
+static uint64_t _next_wakeup(void)
+{
+#ifdef MODULE_XTIMER_COALESCE
+    if (_due_list_head) {
+        unsigned level;
+        uint64_t target = _target64(_due_list_head);
+        uint64_t deadline = _due_deadline();
+        uint64_t start = _next_bucket(&level);
+
+        if (start && (start <= deadline)) {
+            /* the deadline only gets earlier by adding timers, so all
+             * buckets that can contribute are cascaded at once */
+            _advance(deadline - WHEEL_LOOKAHEAD);
+            deadline = _due_deadline();
+        }
+        return (deadline > target) ? deadline : target;
+    }
+#endif
+    return _next_event();
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    if (_in_handler) {
+        return;
+    }
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
+}
+
+static void _program_lltimer(uint64_t next)
+{
+    if (next && (next < (_period_base() + _period_len()))) {
+        /* a coalesced wakeup may be almost due when the timers before it got
+         * removed, don't program a time that passes before the timer is set */
+        uint64_t soonest = _period_base() + _xtimer_lltimer_now() +
+                           XTIMER_ISR_BACKOFF + XTIMER_OVERHEAD;
+        if (next < soonest) {
+            next = soonest;
+        }
+        _period_end_armed = 0;
+        _wakeup = next;
+        _lltimer_set((uint32_t)next - XTIMER_OVERHEAD);
+    }
+    else {
+        _period_end_armed = 1;
+        _wakeup = 0;
+        _lltimer_set(_xtimer_lltimer_mask(0xFFFFFFFF));
+    }
+}
+
+static void _update_lltimer(void)
+{
+    _program_lltimer(_next_wakeup());
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        _xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _remove(timer);
+        }
+
+        _xtimer_now_internal(&timer->target, &timer->long_target);
+        _advance(_target64(timer));
+        timer->target += offset;
+        timer->long_target += long_offset;
+        if (timer->target < offset) {
+            timer->long_target++;
+        }
+#ifdef MODULE_XTIMER_COALESCE
+        timer->slack = 0;
+#endif
+
+        _add(timer);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _xtimer_set_slack(timer, offset, 0);
+}
+
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
+          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        _xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = _xtimer_now() + offset;
+        _set_absolute(timer, target, slack);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    return _set_absolute(timer, target, 0);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack)
+{
+    uint32_t now = _xtimer_now();
+    int res = 0;
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    timer->next = NULL;
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    _advance(((uint64_t)_long_cnt << 32) | now);
+
+    timer->target = target;
+    timer->long_target = _long_cnt;
+    if (target < now) {
+        timer->long_target++;
+    }
+#ifdef MODULE_XTIMER_COALESCE
+    timer->slack = slack;
+#else
+    slack = 0;
+#endif
+
+    /* every timer up to the wakeup still fires in the same sweep, so the new
+     * one can only make the wakeup earlier if its deadline is */
+    uint64_t deadline = _target64(timer) + slack;
+    _add(timer);
+    if (!_wakeup) {
+        DEBUG("timer_set_absolute(): no wakeup in this period. updating lltimer.\n");
+        _update_lltimer();
+    }
+    else if (deadline < _wakeup) {
+        DEBUG("timer_set_absolute(): timer is next event. updating lltimer.\n");
+        _program_lltimer(deadline);
+    }
+
+    irq_restore(state);
+
+    return res;
+}
+
+#ifdef MODULE_XTIMER_COALESCE
+void xtimer_coalesce_stats(xtimer_coalesce_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+#endif
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint32_t reference;
+#ifdef MODULE_XTIMER_COALESCE
+    unsigned fired = 0;
+#endif
+
+    _in_handler = 1;
+
+    if (_period_end_armed) {
+        DEBUG("_timer_callback(): tick\n");
+        /* this was the timer overflow callback, advance to the next period */
+        _next_period();
+        reference = 0;
+
+        /* make sure the timer counter also arrived
+         * in the next timer period */
+        while (_xtimer_lltimer_now() == _xtimer_lltimer_mask(0xFFFFFFFF)) {}
+    }
+    else {
+        /* set our period reference to the current time. */
+        reference = _xtimer_lltimer_now();
+    }
+
+    while (1) {
+        uint32_t ll_now = _xtimer_lltimer_now();
+
+        if (ll_now < reference) {
+            /* executing callbacks took enough time to overflow */
+            DEBUG("_timer_callback: overflowed while executing callbacks.\n");
+            _next_period();
+            reference = 0;
+            continue;
+        }
+
+        uint64_t base = _period_base();
+        uint64_t now = base + ll_now;
+        uint64_t next;
+
+        _advance(now);
+        next = _next_event();
+
+        if (!next || (next >= base + _period_len())) {
+            /* nothing left to do in this period, check if the end of this
+             * period is very soon */
+            if (_xtimer_lltimer_mask(ll_now + XTIMER_ISR_BACKOFF) < ll_now) {
+                /* spin until next period, then advance */
+                while (_xtimer_lltimer_now() >= ll_now) {}
+                _next_period();
+                reference = 0;
+                continue;
+            }
+            break;
+        }
+
+        /* _advance() made sure the next event is a due timer if it is that
+         * close */
+        if ((next - XTIMER_OVERHEAD) >= (now + XTIMER_ISR_BACKOFF)) {
+            break;
+        }
+
+        /* make sure we don't fire too early */
+        while ((next > now) &&
+               (_xtimer_lltimer_now() < _xtimer_lltimer_mask((uint32_t)next))) {}
+
+        /* pick first timer in list */
+        xtimer_t *timer = _due_list_head;
+
+        /* advance list */
+        _due_list_head = timer->next;
+
+        /* make sure timer is recognized as being already fired */
+        timer->target = 0;
+        timer->long_target = 0;
+
+        /* fire timer */
+        _shoot(timer);
+#ifdef MODULE_XTIMER_COALESCE
+        _stats.fired++;
+        if (!fired++) {
+            _stats.sweeps++;
+        }
+#endif
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _update_lltimer();
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure CoAP resource lookups per second for growing resource
+ *              tables
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define MIN_RESOURCES       (8U)
+#define PATH_LEN            (sizeof("/65535/65535"))
+#define URI_LEN             (sizeof("/65535/65535/0/1"))
+
+static coap_resource_t _resources[TEST_RESOURCES_MAX];
+static char _paths[TEST_RESOURCES_MAX][PATH_LEN];
+static char _uris[TEST_RESOURCES_MAX][URI_LEN];
+static char _deep_uris[TEST_RESOURCES_MAX][URI_LEN];
+volatile unsigned _flag = 0;
+
+/* nanocoap's own server resources, not used by this test */
+const coap_resource_t coap_resources[] = {
+    { "/", COAP_GET, NULL, NULL },
+};
+const unsigned coap_resources_numof = 1;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static uint32_t _run(size_t numof, char uris[][URI_LEN])
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        const coap_resource_t *resource;
+        unsigned i = n % numof;
+
+        if ((coap_find_resource(_resources, numof, uris[i], COAP_GET,
+                                &resource) < 0) ||
+            (resource != &_resources[i])) {
+            printf("error: lookup of %s failed\n", uris[i]);
+            return 0;
+        }
+        n++;
+    }
+    return n;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    for (unsigned size = MIN_RESOURCES; size <= TEST_RESOURCES_MAX;
+         size <<= 1) {
+        uint32_t exact, subtree;
+
+        /* object instances /<object>/<instance> of an object tree, zero
+         * padded so they are created in order */
+        while (numof < size) {
+            snprintf(_paths[numof], PATH_LEN, "/%05u/%05u",
+                     (uint16_t)(numof / 8), (uint16_t)(numof % 8));
+            snprintf(_uris[numof], URI_LEN, "%s", _paths[numof]);
+            snprintf(_deep_uris[numof], URI_LEN, "%s/0/1", _paths[numof]);
+            _resources[numof].path = _paths[numof];
+            _resources[numof].methods = COAP_GET | COAP_MATCH_SUBTREE;
+            numof++;
+        }
+
+        if (((exact = _run(numof, _uris)) == 0) ||
+            ((subtree = _run(numof, _deep_uris)) == 0)) {
+            return 1;
+        }
+        printf("{ \"resources\" : %u, \"exact\" : %" PRIu32
+               ", \"subtree\" : %" PRIu32 " }\n", numof, exact, subtree);
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
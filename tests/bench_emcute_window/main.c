@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures QoS 1 publications per second with emcute_window
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/emcute.h"
+#include "net/ipv6/addr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_PUBLISHES      (64U)
+#define GW_PORT             (EMCUTE_DEFAULT_PORT + 1)
+#define GW_TOPIC_ID         (0x0042)
+#define GW_ACKS_MAX         (EMCUTE_WINDOW_SIZE * 2)
+
+/* MQTT-SN message types, see spec v1.2, section 5.2.2 */
+#define CONNECT             (0x04)
+#define CONNACK             (0x05)
+#define REGISTER            (0x0a)
+#define REGACK              (0x0b)
+#define PUBLISH             (0x0c)
+#define PUBACK              (0x0d)
+#define DISCONNECT          (0x18)
+
+typedef struct {
+    uint32_t due;
+    uint8_t id[2];
+} gw_ack_t;
+
+static char _emcute_stack[THREAD_STACKSIZE_DEFAULT];
+static char _gw_stack[THREAD_STACKSIZE_DEFAULT];
+static sock_udp_ep_t _gw = { .family = AF_INET6, .port = GW_PORT };
+
+/* PUBACKs the gateway still has to send */
+static gw_ack_t _gw_acks[GW_ACKS_MAX];
+static unsigned _gw_acks_first, _gw_acks_numof;
+
+static void *_emcute_thread(void *arg)
+{
+    (void)arg;
+    emcute_run(EMCUTE_DEFAULT_PORT, "bench");
+    return NULL;
+}
+
+static void _gw_send_acks(sock_udp_t *sock, const sock_udp_ep_t *client)
+{
+    while (_gw_acks_numof > 0) {
+        gw_ack_t *ack = &_gw_acks[_gw_acks_first];
+        uint8_t buf[7] = { 7, PUBACK, GW_TOPIC_ID >> 8, GW_TOPIC_ID & 0xff,
+                           ack->id[0], ack->id[1], 0 };
+
+        if ((int32_t)(ack->due - xtimer_now_usec()) > 0) {
+            break;
+        }
+        sock_udp_send(sock, buf, sizeof(buf), client);
+        _gw_acks_first = (_gw_acks_first + 1) % GW_ACKS_MAX;
+        _gw_acks_numof--;
+    }
+}
+
+/* a minimal MQTT-SN gateway that delays its PUBACKs by TEST_RTT_USEC */
+static void *_gw_thread(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = GW_PORT };
+    sock_udp_ep_t client;
+    sock_udp_t sock;
+    uint8_t buf[EMCUTE_BUFSIZE];
+
+    (void)arg;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("error: unable to open gateway sock");
+        return NULL;
+    }
+    while (1) {
+        uint32_t timeout = SOCK_NO_TIMEOUT;
+        ssize_t len;
+
+        if (_gw_acks_numof > 0) {
+            int32_t left = _gw_acks[_gw_acks_first].due - xtimer_now_usec();
+
+            timeout = (left > 0) ? (uint32_t)left : 0;
+        }
+        len = sock_udp_recv(&sock, buf, sizeof(buf), timeout, &client);
+        if ((len >= 2) && (buf[0] != 0x01)) {
+            switch (buf[1]) {
+                case CONNECT: {
+                    uint8_t resp[] = { 3, CONNACK, 0 };
+                    sock_udp_send(&sock, resp, sizeof(resp), &client);
+                    break;
+                }
+                case REGISTER: {
+                    uint8_t resp[] = { 7, REGACK, GW_TOPIC_ID >> 8,
+                                       GW_TOPIC_ID & 0xff, buf[4], buf[5], 0 };
+                    sock_udp_send(&sock, resp, sizeof(resp), &client);
+                    break;
+                }
+                case PUBLISH: {
+                    gw_ack_t *ack = &_gw_acks[(_gw_acks_first +
+                                               _gw_acks_numof) % GW_ACKS_MAX];
+
+                    if (_gw_acks_numof == GW_ACKS_MAX) {
+                        puts("error: too many publications in flight");
+                        break;
+                    }
+                    ack->due = xtimer_now_usec() + TEST_RTT_USEC;
+                    memcpy(ack->id, &buf[5], sizeof(ack->id));
+                    _gw_acks_numof++;
+                    break;
+                }
+                case DISCONNECT: {
+                    uint8_t resp[] = { 2, DISCONNECT };
+                    sock_udp_send(&sock, resp, sizeof(resp), &client);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        _gw_send_acks(&sock, &client);
+    }
+    return NULL;
+}
+
+static int _publish(emcute_topic_t *topic, bool serial)
+{
+    uint8_t data[16] = { 0 };
+    uint32_t start = xtimer_now_usec(), usec;
+    int res;
+
+    for (unsigned i = 0; i < TEST_PUBLISHES; i++) {
+        data[0] = i;
+        if ((res = emcute_pub(topic, data, sizeof(data),
+                              EMCUTE_QOS_1)) != EMCUTE_OK) {
+            printf("error: unable to publish (%d)\n", res);
+            return 1;
+        }
+        if (serial && ((res = emcute_flush()) != EMCUTE_OK)) {
+            printf("error: publication failed (%d)\n", res);
+            return 1;
+        }
+    }
+    if ((res = emcute_flush()) != EMCUTE_OK) {
+        printf("error: publication failed (%d)\n", res);
+        return 1;
+    }
+    usec = xtimer_now_usec() - start;
+    printf("{ \"mode\" : \"%s\", \"publishes\" : %u, \"per_sec\" : %" PRIu32
+           " }\n", serial ? "serial" : "window", TEST_PUBLISHES,
+           (uint32_t)(((uint64_t)TEST_PUBLISHES * US_PER_SEC) / usec));
+    return 0;
+}
+
+int main(void)
+{
+    emcute_topic_t topic = { .name = "bench" };
+    int res;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_gw.addr.ipv6);
+    thread_create(_gw_stack, sizeof(_gw_stack), THREAD_PRIORITY_MAIN - 1, 0,
+                  _gw_thread, NULL, "gateway");
+    thread_create(_emcute_stack, sizeof(_emcute_stack),
+                  THREAD_PRIORITY_MAIN - 1, 0, _emcute_thread, NULL, "emcute");
+
+    if ((res = emcute_con(&_gw, true, NULL, NULL, 0, 0)) != EMCUTE_OK) {
+        printf("error: unable to connect (%d)\n", res);
+        return 1;
+    }
+    if ((res = emcute_reg(&topic)) != EMCUTE_OK) {
+        printf("error: unable to register topic (%d)\n", res);
+        return 1;
+    }
+    if ((_publish(&topic, true) != 0) || (_publish(&topic, false) != 0)) {
+        return 1;
+    }
+    emcute_discon();
+
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure FIB next hop lookups per second for growing tables
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define MIN_ROUTES          (8U)
+#define IFACE               (1U)
+
+static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TEST_FIB_TABLE_SIZE,
+                              .mtx_access = MUTEX_INIT };
+volatile unsigned _flag = 0;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+/* route n is the host route 2001:db8:<n>::1 for odd n and
+ * 2001:db8:<n>::/<48, 56, 64, or 72> for even n */
+static void _route(unsigned n, ipv6_addr_t *dst, uint32_t *dst_flags)
+{
+    ipv6_addr_set_unspecified(dst);
+    dst->u16[0] = byteorder_htons(0x2001);
+    dst->u16[1] = byteorder_htons(0x0db8);
+    dst->u16[2] = byteorder_htons(n);
+    if (n & 1) {
+        dst->u8[15] = 1;
+        *dst_flags = 0;
+    }
+    else {
+        *dst_flags = (uint32_t)(48 + (((n >> 1) % 4) * 8)) << FIB_FLAG_NET_PREFIX_SHIFT;
+    }
+}
+
+int main(void)
+{
+    static ipv6_addr_t next_hop = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                            0, 0, 0, 0, 0, 0, 0, 1 } };
+    static ipv6_addr_t dsts[TEST_FIB_TABLE_SIZE];
+    unsigned routes = 0;
+    xtimer_t timer;
+
+    timer.callback = _timer_callback;
+    fib_init(&_table);
+
+    for (unsigned size = MIN_ROUTES; size <= TEST_FIB_TABLE_SIZE; size <<= 1) {
+        uint32_t n = 0;
+
+        while (routes < size) {
+            ipv6_addr_t dst;
+            uint32_t dst_flags;
+
+            _route(routes, &dst, &dst_flags);
+            if (fib_add_entry(&_table, IFACE, dst.u8, sizeof(dst), dst_flags,
+                              next_hop.u8, sizeof(next_hop), 0,
+                              (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+                printf("error: unable to add route %u\n", routes);
+                return 1;
+            }
+            memcpy(&dsts[routes], &dst, sizeof(dst));
+            dsts[routes].u8[15] = 1;
+            routes++;
+        }
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            ipv6_addr_t addr;
+            size_t addr_size = sizeof(addr);
+            kernel_pid_t iface;
+            uint32_t flags;
+
+            if ((fib_get_next_hop(&_table, &iface, addr.u8, &addr_size, &flags,
+                                  dsts[n % routes].u8, sizeof(ipv6_addr_t),
+                                  0) < 0) || (iface != IFACE)) {
+                puts("error: route lookup failed");
+                return 1;
+            }
+            n++;
+        }
+
+        printf("{ \"routes\" : %u, \"result\" : %" PRIu32 " }\n", routes, n);
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
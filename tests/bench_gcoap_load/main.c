@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Load test for gcoap with many open requests and observers
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define OBS_PATH_LEN        (sizeof("/obs/000"))
+#define OBS_PORT            (6000U)
+
+static ssize_t _block_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+static ssize_t _load_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+
+/* sorted by path, as required by gcoap */
+static coap_resource_t _resources[2 + TEST_OBSERVERS] = {
+    { "/block", COAP_GET, _block_handler, NULL },
+    { "/load", COAP_GET, _load_handler, NULL },
+};
+static char _obs_paths[TEST_OBSERVERS][OBS_PATH_LEN];
+static gcoap_listener_t _listener = {
+    _resources, sizeof(_resources) / sizeof(_resources[0]), NULL
+};
+
+static mutex_t _block = MUTEX_INIT;
+static unsigned _responses;
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static sock_udp_t _client;
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+
+static ssize_t _block_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+    /* stalls the gcoap thread until main releases it */
+    mutex_lock(&_block);
+    mutex_unlock(&_block);
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static ssize_t _load_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+    if (req_state == GCOAP_MEMO_RESP) {
+        _responses++;
+    }
+}
+
+static size_t _request(unsigned type, const char *path)
+{
+    coap_pkt_t pdu;
+
+    if (gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET, path) < 0) {
+        return 0;
+    }
+    coap_hdr_set_type(pdu.hdr, type);
+    return gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+}
+
+static int _load(void)
+{
+    uint32_t start, send_usec;
+    size_t len;
+
+    mutex_lock(&_block);
+    len = _request(COAP_TYPE_NON, "/block");
+    if (gcoap_req_send2(_buf, len, &_server, NULL) == 0) {
+        puts("error: unable to send request");
+        return 1;
+    }
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_REQUESTS; i++) {
+        len = _request(COAP_TYPE_CON, "/load");
+        if (gcoap_req_send2(_buf, len, &_server, _resp_handler) == 0) {
+            puts("error: unable to send request");
+            return 1;
+        }
+    }
+    send_usec = xtimer_now_usec() - start;
+    if (gcoap_op_state() != TEST_REQUESTS) {
+        printf("error: %u requests open\n", gcoap_op_state());
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    mutex_unlock(&_block);
+    while (_responses < TEST_REQUESTS) {
+        xtimer_usleep(1000);
+        /* the requests time out after a few seconds */
+        if ((xtimer_now_usec() - start) > (10 * US_PER_SEC)) {
+            printf("error: %u of %u responses received\n", _responses,
+                   (unsigned)TEST_REQUESTS);
+            return 1;
+        }
+    }
+    printf("{ \"requests\" : %u, \"send_usec\" : %" PRIu32
+           ", \"resp_usec\" : %" PRIu32 " }\n", (unsigned)TEST_REQUESTS,
+           send_usec, xtimer_now_usec() - start);
+    if (gcoap_op_state() != 0) {
+        printf("error: %u requests still open\n", gcoap_op_state());
+        return 1;
+    }
+    return 0;
+}
+
+/* registers a client with its own port for every Observable resource */
+static int _register(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+
+    for (unsigned i = 0; i < TEST_OBSERVERS; i++) {
+        uint8_t token[] = { (uint8_t)(i >> 8), (uint8_t)i };
+        ssize_t len = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, token,
+                                     sizeof(token), COAP_METHOD_GET, i);
+        uint8_t *pos = _buf + len;
+
+        pos += coap_put_option(pos, 0, COAP_OPT_OBSERVE, NULL, 0);
+        pos += coap_opt_put_uri_path(pos, COAP_OPT_OBSERVE, _obs_paths[i]);
+        local.port = OBS_PORT + i;
+        /* the registration is handled before sock_udp_send() returns, since
+         * the network stack and gcoap have a higher priority than main, so
+         * the sock can be reused for the next client */
+        if ((sock_udp_create(&_client, &local, NULL, 0) < 0) ||
+            (sock_udp_send(&_client, _buf, pos - _buf, &_server) <= 0)) {
+            puts("error: unable to send registration");
+            return 1;
+        }
+        sock_udp_close(&_client);
+    }
+    return 0;
+}
+
+static int _notify(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_OBSERVERS; i++) {
+        const coap_resource_t *resource = &_resources[2 + i];
+        coap_pkt_t pdu;
+        ssize_t len;
+
+        if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                           resource) != GCOAP_OBS_INIT_OK) {
+            printf("error: no observer for %s\n", resource->path);
+            return 1;
+        }
+        len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+        if ((len <= 0) || (gcoap_obs_send(_buf, len, resource) == 0)) {
+            puts("error: unable to send notification");
+            return 1;
+        }
+    }
+    printf("{ \"observers\" : %u, \"notify_usec\" : %" PRIu32 " }\n",
+           (unsigned)TEST_OBSERVERS, xtimer_now_usec() - start);
+    return 0;
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < TEST_OBSERVERS; i++) {
+        snprintf(_obs_paths[i], OBS_PATH_LEN, "/obs/%03u", i % 1000U);
+        _resources[2 + i].path = _obs_paths[i];
+        _resources[2 + i].methods = COAP_GET;
+        _resources[2 + i].handler = _load_handler;
+    }
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+
+    if ((_load() != 0) || (_register() != 0) || (_notify() != 0)) {
+        return 1;
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
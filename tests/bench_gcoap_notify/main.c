@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of notifying many observers with gcoap
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define OBS_PORT            (6000U)
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/sensor", COAP_GET, _sensor_handler, NULL },
+};
+static gcoap_listener_t _listener = {
+    _resources, sizeof(_resources) / sizeof(_resources[0]), NULL
+};
+
+static const unsigned _steps[] = { 1, 8, 32, TEST_OBSERVERS };
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static sock_udp_t _client;
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+static unsigned _reading;
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+/* stands in for reading and formatting a sensor value */
+static size_t _payload(coap_pkt_t *pdu)
+{
+    _reading++;
+    return snprintf((char *)pdu->payload, pdu->payload_len,
+                    "{\"temp\":%u.%02u,\"hum\":%u.%u,\"seq\":%u}",
+                    20 + (_reading % 5), _reading % 100, 40 + (_reading % 7),
+                    _reading % 10, _reading);
+}
+
+static int _register(unsigned first, unsigned last)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+
+    for (unsigned i = first; i < last; i++) {
+        uint8_t token[] = { (uint8_t)(i >> 8), (uint8_t)i };
+        ssize_t len = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, token,
+                                     sizeof(token), COAP_METHOD_GET, i);
+        uint8_t *pos = _buf + len;
+
+        pos += coap_put_option(pos, 0, COAP_OPT_OBSERVE, NULL, 0);
+        pos += coap_opt_put_uri_path(pos, COAP_OPT_OBSERVE,
+                                     _resources[0].path);
+        local.port = OBS_PORT + i;
+        /* handled before sock_udp_send() returns, as in bench_gcoap_load */
+        if ((sock_udp_create(&_client, &local, NULL, 0) < 0) ||
+            (sock_udp_send(&_client, _buf, pos - _buf, &_server) <= 0)) {
+            puts("error: unable to send registration");
+            return 1;
+        }
+        sock_udp_close(&_client);
+    }
+    return 0;
+}
+
+/* builds and sends the notification for every observer on its own; all of
+ * them go to the same observer, as gcoap_obs_send() only knows one, but cost
+ * the same */
+static int _rebuild(unsigned observers)
+{
+    for (unsigned i = 0; i < observers; i++) {
+        coap_pkt_t pdu;
+        ssize_t len;
+
+        if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                           &_resources[0]) != GCOAP_OBS_INIT_OK) {
+            puts("error: no observer");
+            return 1;
+        }
+        len = gcoap_finish(&pdu, _payload(&pdu), COAP_FORMAT_JSON);
+        if ((len <= 0) || (gcoap_obs_send(_buf, len, &_resources[0]) == 0)) {
+            puts("error: unable to send notification");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* builds the notification once and sends it to all observers */
+static int _batch(unsigned observers)
+{
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    if (gcoap_obs_notify_init(&pdu, _buf, sizeof(_buf),
+                              &_resources[0]) != GCOAP_OBS_INIT_OK) {
+        puts("error: no observer");
+        return 1;
+    }
+    len = gcoap_finish(&pdu, _payload(&pdu), COAP_FORMAT_JSON);
+    if ((len <= 0) ||
+        (gcoap_obs_notify_all(_buf, len, &_resources[0]) != observers)) {
+        puts("error: unable to notify all observers");
+        return 1;
+    }
+    return 0;
+}
+
+static int _measure(int (*notify)(unsigned), unsigned observers,
+                    uint32_t *usec)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        if (notify(observers) != 0) {
+            return 1;
+        }
+        /* let the network stack drain its queue */
+        xtimer_usleep(1000);
+    }
+    *usec = (xtimer_now_usec() - start) / TEST_ROUNDS - 1000;
+    return 0;
+}
+
+/* checks the notification received by an observer with its own token */
+static int _check(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = OBS_PORT };
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    if (sock_udp_create(&_client, &local, NULL, 0) < 0) {
+        puts("error: unable to open client sock");
+        return 1;
+    }
+    if (_batch(TEST_OBSERVERS) != 0) {
+        sock_udp_close(&_client);
+        return 1;
+    }
+    len = sock_udp_recv(&_client, buf, sizeof(buf), US_PER_SEC, NULL);
+    sock_udp_close(&_client);
+    if ((len <= 0) || (coap_parse(&pdu, buf, len) < 0) ||
+        (coap_get_token_len(&pdu) != 2) ||
+        (pdu.token[0] != 0) || (pdu.token[1] != 0) ||
+        !coap_has_observe(&pdu) || (pdu.payload_len == 0)) {
+        puts("error: unexpected notification");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    unsigned observers = 0;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+
+    for (unsigned i = 0; i < sizeof(_steps) / sizeof(_steps[0]); i++) {
+        uint32_t rebuild_usec, batch_usec;
+
+        if ((_register(observers, _steps[i]) != 0) ||
+            (_measure(_rebuild, _steps[i], &rebuild_usec) != 0) ||
+            (_measure(_batch, _steps[i], &batch_usec) != 0)) {
+            return 1;
+        }
+        observers = _steps[i];
+        printf("{ \"observers\" : %u, \"rebuild_usec\" : %" PRIu32
+               ", \"batch_usec\" : %" PRIu32 " }\n", observers, rebuild_usec,
+               batch_usec);
+    }
+    if (_check() != 0) {
+        return 1;
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
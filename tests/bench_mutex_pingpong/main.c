@@ -28,8 +28,17 @@
 #define TEST_DURATION       (1000000U)
 #endif
 
+/* number of additional threads blocking on the mutex with the same priority
+ * as second_thread, each lock then has to queue up behind all of them */
+#ifndef CONTENDERS
+#define CONTENDERS          (0U)
+#endif
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
+#if CONTENDERS
+static char _contender_stacks[CONTENDERS][THREAD_STACKSIZE_DEFAULT];
+#endif
 static mutex_t _mutex = MUTEX_INIT;
 
 static void _timer_callback(void*arg)
@@ -63,7 +72,21 @@ int main(void)
                   NULL,
                   "second_thread");
 
-    /* lock the mutex, then yield to second_thread */
+#if CONTENDERS
+    for (unsigned i = 0; i < CONTENDERS; i++) {
+        thread_create(_contender_stacks[i],
+                      sizeof(_contender_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      _second_thread,
+                      NULL,
+                      "contender");
+    }
+#endif
+
+    printf("contenders: %u\n", (unsigned)CONTENDERS);
+
+    /* lock the mutex, then yield to second_thread (and the contenders) */
     mutex_lock(&_mutex);
     thread_yield_higher();
 
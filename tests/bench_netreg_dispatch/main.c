@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure netreg dispatches per second for growing numbers of
+ *              registered ports
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define TEST_PORT           (0x1000U)
+#define TEST_SOCKETS        (64U)
+
+volatile unsigned _flag = 0;
+static unsigned _received;
+
+static gnrc_netreg_entry_cbd_t _cbd;
+static gnrc_netreg_entry_t _entries[TEST_SOCKETS];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void _receive(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)pkt;
+    (void)ctx;
+    /* the packet is kept for the next dispatch */
+    _received++;
+}
+
+int main(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 0, GNRC_NETTYPE_UNDEF);
+    unsigned sockets = 0;
+    xtimer_t timer;
+
+    if (pkt == NULL) {
+        puts("error: unable to allocate packet");
+        return 1;
+    }
+    _cbd.cb = _receive;
+    timer.callback = _timer_callback;
+
+    for (unsigned size = 1; size <= TEST_SOCKETS; size <<= 1) {
+        uint32_t n = 0;
+
+        while (sockets < size) {
+            gnrc_netreg_entry_init_cb(&_entries[sockets], TEST_PORT + sockets,
+                                      &_cbd);
+            gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[sockets]);
+            sockets++;
+        }
+
+        _received = 0;
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UNDEF, TEST_PORT, pkt);
+            n++;
+        }
+        if (_received != n) {
+            puts("error: packet was not dispatched");
+            return 1;
+        }
+
+        printf("{ \"sockets\" : %u, \"result\" : %" PRIu32 " }\n", sockets, n);
+    }
+
+    gnrc_pktbuf_release(pkt);
+    puts("SUCCESS");
+
+    return 0;
+}
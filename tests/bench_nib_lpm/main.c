@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure NIB route lookups per second for growing route tables
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define MIN_ROUTES          (8U)
+#define IFACE               (1U)
+
+volatile unsigned _flag = 0;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+/* route n is 2001:db8:<n>::/<48, 56, 64, or 72> */
+static void _route(unsigned n, ipv6_addr_t *pfx, unsigned *pfx_len)
+{
+    ipv6_addr_set_unspecified(pfx);
+    pfx->u16[0] = byteorder_htons(0x2001);
+    pfx->u16[1] = byteorder_htons(0x0db8);
+    pfx->u16[2] = byteorder_htons(n);
+    *pfx_len = 48 + ((n % 4) * 8);
+}
+
+int main(void)
+{
+    static const ipv6_addr_t next_hop = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                                  0, 0, 0, 0, 0, 0, 0, 1 } };
+    ipv6_addr_t dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
+    unsigned routes = 0;
+    xtimer_t timer;
+
+    timer.callback = _timer_callback;
+
+    for (unsigned size = MIN_ROUTES; size <= GNRC_IPV6_NIB_OFFL_NUMOF;
+         size <<= 1) {
+        uint32_t n = 0;
+
+        while (routes < size) {
+            ipv6_addr_t pfx;
+            unsigned pfx_len;
+
+            _route(routes, &pfx, &pfx_len);
+            if (gnrc_ipv6_nib_ft_add(&pfx, pfx_len, &next_hop, IFACE, 0) < 0) {
+                printf("error: unable to add route %u\n", routes);
+                return 1;
+            }
+            memcpy(&dsts[routes], &pfx, sizeof(pfx));
+            dsts[routes].u8[15] = 1;
+            routes++;
+        }
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            gnrc_ipv6_nib_ft_t fte;
+
+            if (gnrc_ipv6_nib_ft_get(&dsts[n % routes], NULL, &fte) < 0) {
+                puts("error: route lookup failed");
+                return 1;
+            }
+            n++;
+        }
+
+        printf("{ \"routes\" : %u, \"result\" : %" PRIu32 " }\n", routes, n);
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
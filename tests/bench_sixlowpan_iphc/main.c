@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure IPHC compression and decompression time per packet
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "xtimer.h"
+
+#ifndef TEST_PACKETS
+#define TEST_PACKETS        (10000U)
+#endif
+
+#define PAYLOAD_SIZE        (32U)
+#define COMP_MAX_SIZE       (64U)
+
+static const uint8_t _src_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _dst_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+/* IIDs derived from the link-layer addresses above */
+static const ipv6_addr_t _src = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                          0x00, 0x00, 0x00, 0xff,
+                                          0xfe, 0x00, 0x00, 0x01 } };
+static const ipv6_addr_t _dst = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                          0x00, 0x00, 0x00, 0xff,
+                                          0xfe, 0x00, 0x00, 0x02 } };
+static uint8_t _payload[PAYLOAD_SIZE];
+static uint8_t _comp[COMP_MAX_SIZE];
+static size_t _comp_size;
+
+static gnrc_pktsnip_t *_netif_hdr(void)
+{
+    return gnrc_netif_hdr_build((uint8_t *)_src_l2, sizeof(_src_l2),
+                                (uint8_t *)_dst_l2, sizeof(_dst_l2));
+}
+
+/* builds an uncompressed packet in sending order */
+static gnrc_pktsnip_t *_build(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+    ipv6_hdr_t *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    if ((pkt == NULL) ||
+        ((pkt = gnrc_udp_hdr_build(pkt, 0xf0b1, 0xf0b2)) == NULL) ||
+        ((pkt = gnrc_ipv6_hdr_build(pkt, &_src, &_dst)) == NULL)) {
+        return NULL;
+    }
+    hdr = pkt->data;
+    hdr->len = byteorder_htons(sizeof(udp_hdr_t) + sizeof(_payload));
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = 64;
+    if ((netif = _netif_hdr()) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif->next = pkt;
+    return netif;
+}
+
+/* builds a compressed packet in receiving order */
+static gnrc_pktsnip_t *_build_comp(void)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr();
+
+    if (netif == NULL) {
+        return NULL;
+    }
+    return gnrc_pktbuf_add(netif, _comp, _comp_size, GNRC_NETTYPE_SIXLOWPAN);
+}
+
+static uint32_t _run(gnrc_pktsnip_t *(*build)(void), bool encode,
+                     gnrc_sixlowpan_rbuf_t *rbuf)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_PACKETS; i++) {
+        gnrc_pktsnip_t *pkt = build();
+
+        if (pkt == NULL) {
+            puts("error: packet buffer full");
+            return 0;
+        }
+        if (encode) {
+            if (!gnrc_sixlowpan_iphc_encode(pkt)) {
+                puts("error: unable to compress packet");
+                return 0;
+            }
+            gnrc_pktbuf_release(pkt);
+        }
+        else if (rbuf != NULL) {
+            rbuf->current_size = 0;
+            /* releases pkt */
+            gnrc_sixlowpan_iphc_recv(pkt, rbuf, 0);
+        }
+        else {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static void _print(const char *op, uint32_t base, uint32_t usec)
+{
+    uint32_t ns = (usec > base) ? ((usec - base) * 1000U) / TEST_PACKETS : 0;
+
+    printf("{ \"op\" : \"%s\", \"ns\" : %" PRIu32 " }\n", op, ns);
+}
+
+int main(void)
+{
+    gnrc_sixlowpan_rbuf_t rbuf = { .pkt = NULL };
+    gnrc_pktsnip_t *pkt;
+    ipv6_hdr_t *hdr;
+    uint32_t base;
+
+    for (unsigned i = 0; i < sizeof(_payload); i++) {
+        _payload[i] = i;
+    }
+    gnrc_sixlowpan_ctx_update(1, &_src, 64, UINT16_MAX, true);
+
+    /* compress once to get the compressed packet */
+    if (((pkt = _build()) == NULL) || !gnrc_sixlowpan_iphc_encode(pkt)) {
+        puts("error: unable to compress packet");
+        return 1;
+    }
+    _comp_size = gnrc_pkt_len(pkt->next);
+    if (_comp_size > sizeof(_comp)) {
+        puts("error: compressed packet too large");
+        return 1;
+    }
+    _comp_size = 0;
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy(&_comp[_comp_size], snip->data, snip->size);
+        _comp_size += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    printf("compressed %u bytes of headers to %u\n",
+           (unsigned)(sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)),
+           (unsigned)(_comp_size - sizeof(_payload)));
+
+    base = _run(_build, false, NULL);
+    _print("encode", base, _run(_build, true, NULL));
+
+    rbuf.pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) +
+                               sizeof(udp_hdr_t) + sizeof(_payload),
+                               GNRC_NETTYPE_IPV6);
+    if (rbuf.pkt == NULL) {
+        puts("error: packet buffer full");
+        return 1;
+    }
+    base = _run(_build_comp, false, NULL);
+    _print("decode", base, _run(_build_comp, false, &rbuf));
+
+    hdr = rbuf.pkt->data;
+    if (!ipv6_addr_equal(&hdr->src, &_src) ||
+        !ipv6_addr_equal(&hdr->dst, &_dst) ||
+        (memcmp(((uint8_t *)rbuf.pkt->data) + sizeof(ipv6_hdr_t) +
+                sizeof(udp_hdr_t), _payload, sizeof(_payload)) != 0)) {
+        puts("error: packet decompressed incorrectly");
+        return 1;
+    }
+    gnrc_pktbuf_release(rbuf.pkt);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    const gnrc_sixlowpan_iphc_cache_stats_t *stats;
+
+    stats = gnrc_sixlowpan_iphc_cache_stats();
+    printf("cache hits: %" PRIu32 ", misses: %" PRIu32 "\n", stats->hits,
+           stats->misses);
+#endif
+
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure UDP echo round trips per second for a blocking and an
+ *              event driven sock server
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "event.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/async_event.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef ECHO_TIMEOUT
+#define ECHO_TIMEOUT        (1000000U)
+#endif
+
+#define CLIENT_PORT         (61616U)
+#define BLOCKING_PORT       (CLIENT_PORT + 1)
+#define EVENT_PORT          (CLIENT_PORT + 2)
+#define PAYLOAD_SIZE        (32U)
+
+static char _blocking_stack[THREAD_STACKSIZE_DEFAULT];
+static char _event_stack[THREAD_STACKSIZE_DEFAULT];
+static sock_udp_t _blocking_sock, _event_sock, _client_sock;
+static sock_event_t _sock_event;
+static event_queue_t _queue;
+
+volatile unsigned _flag = 0;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static int _create(sock_udp_t *sock, uint16_t port)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = port,
+                            .netif = SOCK_ADDR_ANY_NETIF };
+
+    memcpy(local.addr.ipv6, &ipv6_addr_loopback, sizeof(local.addr.ipv6));
+    return sock_udp_create(sock, &local, NULL, 0);
+}
+
+static void *_blocking_server(void *arg)
+{
+    uint8_t buf[PAYLOAD_SIZE];
+
+    (void)arg;
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&_blocking_sock, buf, sizeof(buf),
+                                    ECHO_TIMEOUT, &remote);
+
+        if (res >= 0) {
+            sock_udp_send(&_blocking_sock, buf, res, &remote);
+        }
+    }
+    return NULL;
+}
+
+static void _echo(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    uint8_t buf[PAYLOAD_SIZE];
+    sock_udp_ep_t remote;
+    ssize_t res;
+
+    (void)arg;
+    if (!(type & SOCK_ASYNC_MSG_RECV)) {
+        return;
+    }
+    while ((res = sock_udp_recv(sock, buf, sizeof(buf), 0, &remote)) >= 0) {
+        sock_udp_send(sock, buf, res, &remote);
+    }
+}
+
+static void *_event_server(void *arg)
+{
+    (void)arg;
+    event_queue_init(&_queue);
+    sock_udp_event_init(&_event_sock, &_sock_event, &_queue, _echo, NULL);
+    event_loop(&_queue);
+    return NULL;
+}
+
+static int _measure(const char *mode, uint16_t port)
+{
+    static const uint8_t data[PAYLOAD_SIZE];
+    sock_udp_ep_t server = { .family = AF_INET6, .port = port,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+    xtimer_t timer;
+    uint32_t n = 0;
+
+    memcpy(server.addr.ipv6, &ipv6_addr_loopback, sizeof(server.addr.ipv6));
+    timer.callback = _timer_callback;
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        uint8_t buf[PAYLOAD_SIZE];
+
+        if ((sock_udp_send(&_client_sock, data, sizeof(data), &server) < 0) ||
+            (sock_udp_recv(&_client_sock, buf, sizeof(buf), ECHO_TIMEOUT,
+                           NULL) != sizeof(data))) {
+            printf("error: no echo from %s server\n", mode);
+            xtimer_remove(&timer);
+            return -1;
+        }
+        n++;
+    }
+    printf("{ \"mode\" : \"%s\", \"result\" : %" PRIu32 " }\n", mode, n);
+    return 0;
+}
+
+int main(void)
+{
+    if ((_create(&_client_sock, CLIENT_PORT) < 0) ||
+        (_create(&_blocking_sock, BLOCKING_PORT) < 0) ||
+        (_create(&_event_sock, EVENT_PORT) < 0)) {
+        puts("error: unable to create socks");
+        return 1;
+    }
+    thread_create(_blocking_stack, sizeof(_blocking_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _blocking_server, NULL, "blocking");
+    thread_create(_event_stack, sizeof(_event_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _event_server, NULL, "event");
+    if ((_measure("blocking", BLOCKING_PORT) < 0) ||
+        (_measure("event", EVENT_PORT) < 0)) {
+        return 1;
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
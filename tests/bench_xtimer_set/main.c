@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer set/remove cost vs. number of armed timers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "xtimer.h"
+
+#ifndef TIMERS_MAX
+#define TIMERS_MAX          (256U)
+#endif
+
+#ifndef REPEAT
+#define REPEAT              (64U)
+#endif
+
+/* armed timers expire between 30s and ~60s, long after the benchmark is
+ * finished */
+#define TIMER_OFFSET_MIN    (30U * US_PER_SEC)
+#define TIMER_OFFSET_SPREAD (0x01ffffffU)
+#define PROBE_OFFSET        (120U * US_PER_SEC)
+
+static xtimer_t _timers[TIMERS_MAX];
+static xtimer_t _probe;
+static uint32_t _lcg = 1;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired");
+}
+
+static uint32_t _rand(void)
+{
+    _lcg = (_lcg * 1103515245U) + 12345U;
+    return _lcg;
+}
+
+int main(void)
+{
+    unsigned armed = 0;
+
+    puts("xtimer set/remove benchmark");
+#ifdef MODULE_XTIMER_WHEEL
+    puts("backend: xtimer_wheel");
+#else
+    puts("backend: xtimer_core");
+#endif
+
+    _probe.callback = _cb;
+    for (unsigned i = 0; i < TIMERS_MAX; i++) {
+        _timers[i].callback = _cb;
+    }
+
+    for (unsigned n = 1; n <= TIMERS_MAX; n <<= 1) {
+        uint32_t set_sum = 0, set_max = 0;
+        uint32_t rem_sum = 0, rem_max = 0;
+
+        while (armed < n) {
+            xtimer_set(&_timers[armed++],
+                       TIMER_OFFSET_MIN + (_rand() & TIMER_OFFSET_SPREAD));
+        }
+
+        for (unsigned i = 0; i < REPEAT; i++) {
+            uint32_t start, diff;
+
+            start = xtimer_now().ticks32;
+            xtimer_set(&_probe, PROBE_OFFSET);
+            diff = xtimer_now().ticks32 - start;
+            set_sum += diff;
+            if (diff > set_max) {
+                set_max = diff;
+            }
+
+            start = xtimer_now().ticks32;
+            xtimer_remove(&_probe);
+            diff = xtimer_now().ticks32 - start;
+            rem_sum += diff;
+            if (diff > rem_max) {
+                rem_max = diff;
+            }
+        }
+
+        printf("{ \"timers\" : %u, \"set_avg\" : %" PRIu32
+               ", \"set_max\" : %" PRIu32 ", \"remove_avg\" : %" PRIu32
+               ", \"remove_max\" : %" PRIu32 " }\n",
+               n, set_sum / REPEAT, set_max, rem_sum / REPEAT, rem_max);
+    }
+
+    for (unsigned i = 0; i < armed; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"backend: xtimer_\w+")
+    n = 1
+    while n <= 256:
+        child.expect(r"{ \"timers\" : %d, \"set_avg\" : \d+, \"set_max\" : \d+, "
+                     r"\"remove_avg\" : \d+, \"remove_max\" : \d+ }" % n)
+        n <<= 1
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
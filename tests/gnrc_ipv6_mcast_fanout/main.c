@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests that multicast fan-out over several interfaces only
+ *              duplicates the headers of a packet
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "byteorder.h"
+#include "net/ethernet.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define TEST_PORT           (8808U)
+#define TEST_PAYLOAD_SIZE   (64U)
+#define TEST_IFACES         (2U)
+/* captured parts of a frame: IPv6 header, UDP header, UDP payload */
+#define TEST_PARTS          (3U)
+
+typedef struct {
+    const void *base[TEST_PARTS];
+    size_t len[TEST_PARTS];
+    uint16_t ipv6_len;
+} _frame_t;
+
+static char _netif_stacks[TEST_IFACES][THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _devs[TEST_IFACES];
+static const unsigned _idx[TEST_IFACES] = { 0, 1 };
+static _frame_t _frames[TEST_IFACES];
+static volatile unsigned _frames_numof;
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_max_packet_size(netdev_t *netdev, void *value,
+                                       size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _netdev_send(netdev_t *netdev, const iolist_t *iolist)
+{
+    const unsigned idx = *((const unsigned *)((netdev_test_t *)netdev)->state);
+    const iolist_t *part = iolist->iol_next;    /* skip Ethernet header */
+    const ipv6_hdr_t *ipv6;
+    const udp_hdr_t *udp;
+    _frame_t *frame = &_frames[idx];
+
+    /* ignore everything but the test packet (e.g. NDP) */
+    if ((part == NULL) || (part->iol_len != sizeof(ipv6_hdr_t))) {
+        return 0;
+    }
+    ipv6 = part->iol_base;
+    if ((ipv6->nh != PROTNUM_UDP) || (part->iol_next == NULL)) {
+        return 0;
+    }
+    udp = part->iol_next->iol_base;
+    if (byteorder_ntohs(udp->dst_port) != TEST_PORT) {
+        return 0;
+    }
+    frame->ipv6_len = byteorder_ntohs(ipv6->len);
+    for (unsigned i = 0; (i < TEST_PARTS) && (part != NULL); i++) {
+        frame->base[i] = part->iol_base;
+        frame->len[i] = part->iol_len;
+        part = part->iol_next;
+    }
+    _frames_numof++;
+    return 0;
+}
+
+static void _init_interfaces(void)
+{
+    for (unsigned i = 0; i < TEST_IFACES; i++) {
+        netdev_test_setup(&_devs[i], (void *)&_idx[i]);
+        netdev_test_set_get_cb(&_devs[i], NETOPT_DEVICE_TYPE,
+                               _get_netdev_device_type);
+        netdev_test_set_get_cb(&_devs[i], NETOPT_MAX_PACKET_SIZE,
+                               _get_netdev_max_packet_size);
+        netdev_test_set_send_cb(&_devs[i], _netdev_send);
+        gnrc_netif_ethernet_create(_netif_stacks[i], THREAD_STACKSIZE_DEFAULT,
+                                   GNRC_NETIF_PRIO, "dummy_netif",
+                                   (netdev_t *)&_devs[i]);
+    }
+    xtimer_usleep(500); /* wait for threads to start */
+}
+
+static int _send_multicast(void)
+{
+    static const uint8_t data[TEST_PAYLOAD_SIZE];
+    ipv6_addr_t dst = IPV6_ADDR_ALL_NODES_LINK_LOCAL;
+    gnrc_pktsnip_t *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, data, sizeof(data), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_udp_hdr_build(pkt, TEST_PORT, TEST_PORT);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_ipv6_hdr_build(pkt, NULL, &dst);
+    if (pkt == NULL) {
+        return -1;
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6,
+                                   GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    for (unsigned i = 0; (i < 100) && (_frames_numof < TEST_IFACES); i++) {
+        xtimer_usleep(1000);
+    }
+    return (_frames_numof == TEST_IFACES) ? 0 : -1;
+}
+
+int main(void)
+{
+    size_t duplicated = 0;
+    bool success = true, shared;
+
+    _init_interfaces();
+    if (_send_multicast() < 0) {
+        puts("FAILED: packet was not sent over all interfaces");
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_IFACES; i++) {
+        if (_frames[i].ipv6_len != (sizeof(udp_hdr_t) + TEST_PAYLOAD_SIZE)) {
+            printf("IPv6 header not filled for interface %u\n", i);
+            success = false;
+        }
+    }
+    for (unsigned i = 0; i < TEST_PARTS; i++) {
+        if (_frames[0].base[i] != _frames[1].base[i]) {
+            duplicated += _frames[0].len[i];
+        }
+    }
+    shared = (_frames[0].base[TEST_PARTS - 1] == _frames[1].base[TEST_PARTS - 1]);
+    printf("payload shared: %s\n", shared ? "yes" : "no");
+    printf("bytes duplicated for fan-out: %u\n", (unsigned)duplicated);
+    if (!shared || (duplicated > (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)))) {
+        success = false;
+    }
+    puts(success ? "SUCCESS" : "FAILED");
+
+    return 0;
+}
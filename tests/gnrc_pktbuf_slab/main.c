@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the size classes of the slab packet buffer backend
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+
+#define TEST_DATA_SIZE  (48U)
+
+static const uint8_t _test_data[TEST_DATA_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+};
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void test_pktbuf_slab_add__too_large(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_MTU_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__class_exhausted(void)
+{
+    gnrc_pktsnip_t *mtu[GNRC_PKTBUF_SLAB_MTU_NUMOF];
+    gnrc_pktsnip_t *pkt;
+    void *data;
+
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_MTU_NUMOF; i++) {
+        mtu[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_MTU_SIZE,
+                                 GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(mtu[i]);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_MTU_SIZE,
+                                     GNRC_NETTYPE_TEST));
+    /* smaller classes are unaffected */
+    pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_FRAME_SIZE,
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_release(pkt);
+    /* a released block is reused right away */
+    data = mtu[0]->data;
+    gnrc_pktbuf_release(mtu[0]);
+    mtu[0] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_MTU_SIZE,
+                             GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(mtu[0]);
+    TEST_ASSERT(data == mtu[0]->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_MTU_NUMOF; i++) {
+        gnrc_pktbuf_release(mtu[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__fallback(void)
+{
+    gnrc_pktsnip_t *small[GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+    gnrc_pktsnip_t *pkt;
+
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_SMALL_NUMOF; i++) {
+        small[i] = gnrc_pktbuf_add(NULL, _test_data, 1, GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(small[i]);
+    }
+    /* served by the next larger class */
+    pkt = gnrc_pktbuf_add(NULL, _test_data, 1, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(_test_data[0], *((uint8_t *)pkt->data));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_SMALL_NUMOF; i++) {
+        gnrc_pktbuf_release(small[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__snips_exhausted(void)
+{
+    gnrc_pktsnip_t *pkt = NULL, *next;
+    unsigned num = 0;
+
+    while ((next = gnrc_pktbuf_add(pkt, NULL, 0, GNRC_NETTYPE_TEST)) != NULL) {
+        pkt = next;
+        num++;
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_SNIP_NUMOF, num);
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, _test_data, 1, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_mark__shares_block(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _test_data, TEST_DATA_SIZE,
+                                          GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr;
+    uint8_t *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(hdr == pkt->next);
+    TEST_ASSERT(data == hdr->data);
+    TEST_ASSERT(data + 8 == pkt->data);
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_SIZE - 8, pkt->size);
+    /* the block stays allocated as long as one snip points into it */
+    pkt->next = NULL;
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, &_test_data[8], pkt->size));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data__in_place(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _test_data, 8, GNRC_NETTYPE_TEST);
+    void *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, TEST_DATA_SIZE));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 4));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, _test_data, 4));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data__move(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _test_data, TEST_DATA_SIZE,
+                                          GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* block is shared with pkt so it must not grow in place */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 16));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(hdr->data, _test_data, 8));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, &_test_data[8],
+                                    TEST_DATA_SIZE - 8));
+    TEST_ASSERT_EQUAL_INT(ENOMEM,
+                          gnrc_pktbuf_realloc_data(pkt,
+                                                   GNRC_PKTBUF_SLAB_MTU_SIZE + 1));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_slab(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_add__too_large),
+        new_TestFixture(test_pktbuf_slab_add__class_exhausted),
+        new_TestFixture(test_pktbuf_slab_add__fallback),
+        new_TestFixture(test_pktbuf_slab_add__snips_exhausted),
+        new_TestFixture(test_pktbuf_slab_mark__shares_block),
+        new_TestFixture(test_pktbuf_slab_realloc_data__in_place),
+        new_TestFixture(test_pktbuf_slab_realloc_data__move),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_slab());
+    TESTS_END();
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Node for the 6LoWPAN fragment forwarding test
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "shell.h"
+
+#define MAIN_QUEUE_SIZE     (8)
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static int _vrb_cmd(int argc, char **argv)
+{
+    const gnrc_sixlowpan_frag_vrb_stats_t *stats = gnrc_sixlowpan_frag_vrb_stats();
+
+    (void)argc;
+    (void)argv;
+    printf("forwarded datagrams: %" PRIu32 ", fragments: %" PRIu32 "\n",
+           stats->datagrams, stats->fragments);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "vrb", "show virtual reassembly buffer statistics", _vrb_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    /* ping6 needs a message queue to receive replies */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
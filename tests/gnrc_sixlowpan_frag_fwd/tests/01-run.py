@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import signal
+import sys
+import time
+
+import pexpect
+from testrunner import run
+
+# node A is the node started by the testrunner (see TERMFLAGS in Makefile)
+ROUTER_TERMFLAGS = "-z [::1]:17761,[::1]:17760 -z [::1]:17762,[::1]:17763"
+NODE_C_TERMFLAGS = "-z [::1]:17763,[::1]:17762 -z [::1]:17766,[::1]:17767"
+NODE_A_ADDR = "2001:db8::a"
+NODE_C_ADDR = "2001:db8::c"
+PING_PAYLOAD = 600
+
+
+def spawn(termflags):
+    env = os.environ.copy()
+    env["TERMFLAGS"] = termflags
+    child = pexpect.spawnu("make term", env=env, timeout=10,
+                           codec_errors='replace')
+    child.logfile = sys.stdout
+    return child
+
+
+def kill(child):
+    try:
+        os.killpg(os.getpgid(child.pid), signal.SIGKILL)
+    except ProcessLookupError:
+        pass
+    child.close()
+
+
+def link_locals(child):
+    """returns (interface, link-local address) for both ZEP interfaces"""
+    res = []
+    child.sendline("ifconfig")
+    for _ in range(2):
+        child.expect(r"Iface\s+(\d+)")
+        iface = child.match.group(1)
+        child.expect(r"inet6 addr: (fe80:[0-9a-fA-F:]+)")
+        res.append((iface, child.match.group(1)))
+    return res
+
+
+def testfunc(node_a):
+    router = spawn(ROUTER_TERMFLAGS)
+    node_c = spawn(NODE_C_TERMFLAGS)
+    try:
+        time.sleep(1)
+        iface_a, ll_a = link_locals(node_a)[0]
+        (iface_r1, ll_r1), (iface_r2, ll_r2) = link_locals(router)
+        iface_c, ll_c = link_locals(node_c)[0]
+
+        # /128, as a shared on-link /64 would make A and C talk directly
+        node_a.sendline("ifconfig {} add {}/128".format(iface_a, NODE_A_ADDR))
+        node_a.sendline("nib route add {} default {}".format(iface_a, ll_r1))
+        node_c.sendline("ifconfig {} add {}/128".format(iface_c, NODE_C_ADDR))
+        node_c.sendline("nib route add {} default {}".format(iface_c, ll_r2))
+        router.sendline("nib route add {} {}/128 {}".format(iface_r1,
+                                                            NODE_A_ADDR, ll_a))
+        router.sendline("nib route add {} {}/128 {}".format(iface_r2,
+                                                            NODE_C_ADDR, ll_c))
+        time.sleep(1)
+
+        node_a.sendline("ping6 3 {} {}".format(NODE_C_ADDR, PING_PAYLOAD))
+        node_a.expect(r"3 packets transmitted, [1-3] received", timeout=15)
+        router.sendline("vrb")
+        router.expect(r"forwarded datagrams: [1-9]\d*, fragments: [1-9]\d*")
+    finally:
+        kill(router)
+        kill(node_c)
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for the 6LoWPAN reassembly buffer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SENDERS             (RBUF_SIZE)
+#define ROUNDS              (8U)
+#define DATAGRAM_SIZE       (256U)
+#define FRAG_SIZE           (64U)
+#define FRAGS               (DATAGRAM_SIZE / FRAG_SIZE)
+#define MSG_QUEUE_SIZE      (2 * SENDERS)
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_handler = GNRC_NETREG_ENTRY_INIT_PID(
+        GNRC_NETREG_DEMUX_CTX_ALL, KERNEL_PID_UNDEF
+    );
+static uint8_t _dst[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+
+/* content of the datagrams, never starts with an IPv6 header so the IPv6
+ * thread ignores it */
+static inline uint8_t _pattern(unsigned sender, unsigned idx)
+{
+    return (uint8_t)(idx ^ sender);
+}
+
+static void _send(unsigned sender, uint16_t tag, unsigned offset,
+                  unsigned size)
+{
+    uint8_t src[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x10, sender };
+    size_t hdr_size = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                    : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_n_t *hdr;
+    uint8_t *data;
+
+    netif = gnrc_netif_hdr_build(src, sizeof(src), _dst, sizeof(_dst));
+    if (netif == NULL) {
+        puts("error: packet buffer full");
+        return;
+    }
+    pkt = gnrc_pktbuf_add(netif, NULL, hdr_size + size,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        puts("error: packet buffer full");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    data = ((uint8_t *)pkt->data) + hdr_size;
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        data[-1] = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+    }
+    for (unsigned i = 0; i < size; i++) {
+        data[i] = _pattern(sender, offset + i);
+    }
+    gnrc_sixlowpan_frag_recv(pkt, NULL, 0);
+}
+
+static inline void _send_frag(unsigned sender, uint16_t tag, unsigned frag)
+{
+    _send(sender, tag, frag * FRAG_SIZE, FRAG_SIZE);
+}
+
+/* returns the number of correctly reassembled datagrams received so far */
+static unsigned _collect(void)
+{
+    unsigned complete = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        gnrc_netif_hdr_t *netif_hdr;
+        unsigned sender;
+
+        if (msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF) {
+            gnrc_sixlowpan_frag_rbuf_gc();
+            continue;
+        }
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        netif_hdr = pkt->next->data;
+        sender = gnrc_netif_hdr_get_src_addr(netif_hdr)[7];
+        if (pkt->size != DATAGRAM_SIZE) {
+            printf("error: unexpected datagram size %u\n",
+                   (unsigned)pkt->size);
+        }
+        else {
+            unsigned i;
+
+            for (i = 0; i < DATAGRAM_SIZE; i++) {
+                if (((uint8_t *)pkt->data)[i] != _pattern(sender, i)) {
+                    printf("error: datagram of %u corrupted at %u\n",
+                           sender, i);
+                    break;
+                }
+            }
+            if (i == DATAGRAM_SIZE) {
+                complete++;
+            }
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return complete;
+}
+
+int main(void)
+{
+    const gnrc_sixlowpan_frag_rbuf_stats_t *stats;
+    uint16_t tag = 0;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    _ipv6_handler.target.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_handler);
+    stats = gnrc_sixlowpan_frag_rbuf_stats();
+
+    /* phase 1: as many senders as there is room for in the reassembly
+     * buffer */
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        unsigned fragments = 0, complete;
+        uint32_t start = xtimer_now_usec();
+
+        for (unsigned frag = 0; frag < FRAGS; frag++) {
+            for (unsigned sender = 0; sender < SENDERS; sender++) {
+                _send_frag(sender, tag, frag);
+                fragments++;
+                /* the last fragment completes the datagram, so only repeat
+                 * one in between */
+                if (frag == 1) {
+                    _send_frag(sender, tag, frag);
+                    fragments++;
+                }
+            }
+        }
+        printf("{ \"senders\" : %u, \"fragments\" : %u, \"usec\" : %" PRIu32
+               " }\n", (unsigned)SENDERS, fragments,
+               xtimer_now_usec() - start);
+        tag++;
+        if ((complete = _collect()) != SENDERS) {
+            printf("error: %u of %u datagrams reassembled\n", complete,
+                   (unsigned)SENDERS);
+            return 1;
+        }
+    }
+    if ((stats->evicted != 0) ||
+        (stats->duplicates != (ROUNDS * SENDERS))) {
+        printf("error: unexpected statistics (evicted: %" PRIu32
+               ", duplicates: %" PRIu32 ")\n", stats->evicted,
+               stats->duplicates);
+        return 1;
+    }
+
+    /* phase 2: twice as many senders, so datagrams are evicted before they
+     * are complete */
+    for (unsigned frag = 0; frag < FRAGS; frag++) {
+        for (unsigned sender = 0; sender < (2 * SENDERS); sender++) {
+            _send_frag(sender, tag, frag);
+        }
+    }
+    _collect();
+    printf("evicted: %" PRIu32 ", timed out: %" PRIu32 ", discarded: %"
+           PRIu32 ", duplicates: %" PRIu32 "\n", stats->evicted,
+           stats->timed_out, stats->discarded, stats->duplicates);
+    /* at least the first fragments of the second half of the senders had to
+     * make room */
+    if (stats->evicted < SENDERS) {
+        puts("error: too few evictions");
+        return 1;
+    }
+
+    /* phase 3: a fragment covering the same units as two earlier ones is no
+     * duplicate, but an overlap that discards the datagram (RFC 4944, 5.3) */
+    uint32_t discarded = stats->discarded, duplicates = stats->duplicates;
+
+    tag++;
+    _send(0, tag, FRAG_SIZE, FRAG_SIZE / 2);
+    _send(0, tag, FRAG_SIZE + (FRAG_SIZE / 2), FRAG_SIZE / 2);
+    _send(0, tag, FRAG_SIZE, FRAG_SIZE);
+    if ((stats->discarded != (discarded + 1)) ||
+        (stats->duplicates != duplicates)) {
+        puts("error: overlapping fragment taken as duplicate");
+        return 1;
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests out-of-order reassembly and SACK generation of GNRC TCP
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/af.h"
+#include "net/ethernet.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define LOCAL_PORT          (80U)
+#define PEER_PORT           (1234U)
+#define PEER_ISS            (1000U)
+#define PEER_WND            (1024U)
+#define SEG_SIZE            (64U)
+#define SEG_NUMOF           (4U)
+#define SACK_BLOCKS_MAX     (4U)
+#define CAPTURE_NUMOF       (16U)
+
+#define CTL_SYN             (0x0002)
+#define CTL_PSH             (0x0008)
+#define CTL_ACK             (0x0010)
+
+typedef struct {
+    uint16_t ctl;
+    uint32_t seq;
+    uint32_t ack;
+    bool sack_perm;
+    unsigned sack_numof;
+    uint32_t sack[SACK_BLOCKS_MAX][2];
+} _seg_t;
+
+static const ipv6_addr_t _local = { .u8 = { 0xfd, 0x01, 0, 0, 0, 0, 0, 0,
+                                            0, 0, 0, 0, 0, 0, 0, 2 } };
+static const ipv6_addr_t _peer = { .u8 = { 0xfd, 0x01, 0, 0, 0, 0, 0, 0,
+                                           0, 0, 0, 0, 0, 0, 0, 1 } };
+static const uint8_t _peer_l2addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _data[SEG_NUMOF * SEG_SIZE];
+static uint8_t _rcvd[SEG_NUMOF * SEG_SIZE];
+
+static _seg_t _segs[CAPTURE_NUMOF];
+static volatile unsigned _segs_numof;
+static volatile bool _connected;
+static volatile int _rcvd_numof;
+
+static inline uint32_t _get_u32(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+           ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_max_packet_size(netdev_t *netdev, void *value,
+                                       size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static void _parse_tcp(_seg_t *seg, const uint8_t *data)
+{
+    const tcp_hdr_t *hdr = (const tcp_hdr_t *)data;
+    uint16_t off_ctl = byteorder_ntohs(hdr->off_ctl);
+    const uint8_t *opt = data + sizeof(tcp_hdr_t);
+    const uint8_t *end = data + ((off_ctl >> 12) * 4);
+
+    memset(seg, 0, sizeof(*seg));
+    seg->ctl = off_ctl & 0x3f;
+    seg->seq = byteorder_ntohl(hdr->seq_num);
+    seg->ack = byteorder_ntohl(hdr->ack_num);
+    while ((opt < end) && (opt[0] != TCP_OPTION_KIND_EOL)) {
+        if (opt[0] == TCP_OPTION_KIND_NOP) {
+            opt++;
+            continue;
+        }
+        if (opt[0] == TCP_OPTION_KIND_SACK_PERM) {
+            seg->sack_perm = true;
+        }
+        else if (opt[0] == TCP_OPTION_KIND_SACK) {
+            for (unsigned i = 2; ((i + TCP_OPTION_LENGTH_SACK_BLOCK) <= opt[1]) &&
+                 (seg->sack_numof < SACK_BLOCKS_MAX);
+                 i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                seg->sack[seg->sack_numof][0] = _get_u32(&opt[i]);
+                seg->sack[seg->sack_numof][1] = _get_u32(&opt[i + 4]);
+                seg->sack_numof++;
+            }
+        }
+        if (opt[1] < 2) {
+            break;
+        }
+        opt += opt[1];
+    }
+}
+
+static int _netdev_send(netdev_t *netdev, const iolist_t *iolist)
+{
+    const iolist_t *part = iolist->iol_next;    /* skip Ethernet header */
+    (void)netdev;
+
+    /* only capture TCP segments (e.g. no NDP) */
+    if ((part == NULL) || (part->iol_len != sizeof(ipv6_hdr_t)) ||
+        (((ipv6_hdr_t *)part->iol_base)->nh != PROTNUM_TCP) ||
+        (part->iol_next == NULL) || (_segs_numof >= CAPTURE_NUMOF)) {
+        return 0;
+    }
+    _parse_tcp(&_segs[_segs_numof], part->iol_next->iol_base);
+    _segs_numof++;
+    return 0;
+}
+
+static void _init_interface(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE,
+                           _get_netdev_max_packet_size);
+    netdev_test_set_send_cb(&_dev, _netdev_send);
+    _netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                        GNRC_NETIF_PRIO, "dummy_netif",
+                                        (netdev_t *)&_dev);
+    xtimer_usleep(500); /* wait for thread to start */
+    if (gnrc_netapi_set(_netif->pid, NETOPT_IPV6_ADDR, 64U << 8U,
+                        (void *)&_local, sizeof(_local)) < 0) {
+        puts("error: unable to add IPv6 address fd01::2/64");
+    }
+    /* the peer does not answer neighbor solicitations */
+    gnrc_ipv6_nib_nc_set(&_peer, _netif->pid, _peer_l2addr,
+                         sizeof(_peer_l2addr));
+}
+
+/* Injects a segment from the peer as if it was received by the interface */
+static void _inject(uint16_t ctl, uint32_t seq, uint32_t ack,
+                    const uint8_t *opt, size_t opt_len,
+                    const uint8_t *payload, size_t payload_len)
+{
+    static uint8_t data[sizeof(ipv6_hdr_t) + sizeof(tcp_hdr_t) + 8 + SEG_SIZE];
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)data;
+    tcp_hdr_t *tcp = (tcp_hdr_t *)(ipv6 + 1);
+    uint16_t tcp_len = sizeof(tcp_hdr_t) + opt_len + payload_len;
+    uint16_t csum;
+    gnrc_netif_hdr_t netif_hdr;
+    gnrc_pktsnip_t *netif, *pkt;
+
+    assert((opt_len + payload_len) <= (8 + SEG_SIZE));
+    memset(data, 0, sizeof(data));
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(tcp_len);
+    ipv6->nh = PROTNUM_TCP;
+    ipv6->hl = 64;
+    memcpy(&ipv6->src, &_peer, sizeof(_peer));
+    memcpy(&ipv6->dst, &_local, sizeof(_local));
+    tcp->src_port = byteorder_htons(PEER_PORT);
+    tcp->dst_port = byteorder_htons(LOCAL_PORT);
+    tcp->seq_num = byteorder_htonl(seq);
+    tcp->ack_num = byteorder_htonl(ack);
+    tcp->off_ctl = byteorder_htons(((TCP_HDR_OFFSET_MIN + (opt_len / 4)) << 12) | ctl);
+    tcp->window = byteorder_htons(PEER_WND);
+    memcpy((uint8_t *)(tcp + 1), opt, opt_len);
+    memcpy((uint8_t *)(tcp + 1) + opt_len, payload, payload_len);
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_TCP, tcp_len);
+    csum = inet_csum(csum, (uint8_t *)tcp, tcp_len);
+    tcp->checksum = byteorder_htons(~csum);
+
+    gnrc_netif_hdr_init(&netif_hdr, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
+    netif_hdr.if_pid = _netif->pid;
+    netif = gnrc_pktbuf_add(NULL, &netif_hdr, sizeof(netif_hdr),
+                            GNRC_NETTYPE_NETIF);
+    pkt = gnrc_pktbuf_add(netif, data, sizeof(ipv6_hdr_t) + tcp_len,
+                          GNRC_NETTYPE_UNDEF);
+    if ((netif == NULL) || (pkt == NULL)) {
+        puts("error: packet buffer full");
+        return;
+    }
+    gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+                                 pkt);
+}
+
+static void _inject_data(unsigned idx, uint32_t ack)
+{
+    _inject(CTL_ACK | CTL_PSH, PEER_ISS + 1 + (idx * SEG_SIZE), ack, NULL, 0,
+            &_data[idx * SEG_SIZE], SEG_SIZE);
+}
+
+/* Waits for the segment with index idx to be sent by the server */
+static _seg_t *_expect(unsigned idx)
+{
+    for (unsigned i = 0; (i < 100) && (_segs_numof <= idx); i++) {
+        xtimer_usleep(1000);
+    }
+    return (_segs_numof > idx) ? &_segs[idx] : NULL;
+}
+
+static bool _check_sack(const char *name, const _seg_t *seg, unsigned numof)
+{
+    if ((seg == NULL) || !(seg->ctl & CTL_ACK) || (seg->ack != (PEER_ISS + 1))) {
+        printf("no duplicate ACK after %s\n", name);
+        return false;
+    }
+    printf("SACK after %s:", name);
+    for (unsigned i = 0; i < seg->sack_numof; i++) {
+        printf(" [%lu, %lu)", (unsigned long)seg->sack[i][0],
+               (unsigned long)seg->sack[i][1]);
+    }
+    puts("");
+    return (seg->sack_numof == numof);
+}
+
+static void *_server_thread(void *arg)
+{
+    int res;
+    (void)arg;
+
+    gnrc_tcp_tcb_init(&_tcb);
+    if ((res = gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, LOCAL_PORT)) < 0) {
+        printf("gnrc_tcp_open_passive() : %d\n", res);
+        return NULL;
+    }
+    _connected = true;
+    while (_rcvd_numof < (int)sizeof(_rcvd)) {
+        res = gnrc_tcp_recv(&_tcb, &_rcvd[_rcvd_numof],
+                            sizeof(_rcvd) - _rcvd_numof,
+                            GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        if (res < 0) {
+            printf("gnrc_tcp_recv() : %d\n", res);
+            return NULL;
+        }
+        _rcvd_numof += res;
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    /* MSS option, SACK permitted option padded with NOP options */
+    static const uint8_t syn_opt[] = { TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS,
+                                       (SEG_SIZE >> 8), (SEG_SIZE & 0xff),
+                                       TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                                       TCP_OPTION_KIND_SACK_PERM,
+                                       TCP_OPTION_LENGTH_SACK_PERM };
+    uint32_t ack;
+    unsigned idx = 0;
+    _seg_t *seg;
+    bool success = true;
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (uint8_t)i;
+    }
+    _init_interface();
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server_thread, NULL, "server");
+
+    /* three-way handshake, negotiating SACK */
+    _inject(CTL_SYN, PEER_ISS, 0, syn_opt, sizeof(syn_opt), NULL, 0);
+    seg = _expect(idx++);
+    if ((seg == NULL) || ((seg->ctl & (CTL_SYN | CTL_ACK)) != (CTL_SYN | CTL_ACK)) ||
+        !seg->sack_perm) {
+        puts("FAILED: no SYN+ACK offering SACK");
+        return 1;
+    }
+    ack = seg->seq + 1;
+    _inject(CTL_ACK, PEER_ISS + 1, ack, NULL, 0, NULL, 0);
+    for (unsigned i = 0; (i < 100) && !_connected; i++) {
+        xtimer_usleep(1000);
+    }
+    if (!_connected) {
+        puts("FAILED: connection not established");
+        return 1;
+    }
+    puts("connection established");
+
+    /* segment 0 is lost, the others arrive reordered */
+    _inject_data(1, ack);
+    success &= _check_sack("segment 1", _expect(idx++), 1);
+    _inject_data(3, ack);
+    success &= _check_sack("segment 3", _expect(idx++), 2);
+    _inject_data(2, ack);
+    success &= _check_sack("segment 2", _expect(idx++), 1);
+
+    /* the retransmission of segment 0 fills the gap */
+    _inject_data(0, ack);
+    seg = _expect(idx++);
+    if ((seg == NULL) || (seg->sack_numof > 0)) {
+        puts("FAILED: no cumulative ACK after segment 0");
+        return 1;
+    }
+    printf("ACK after segment 0: %lu\n", (unsigned long)seg->ack);
+    success &= (seg->ack == (PEER_ISS + 1 + sizeof(_data)));
+
+    for (unsigned i = 0; (i < 100) && (_rcvd_numof < (int)sizeof(_rcvd)); i++) {
+        xtimer_usleep(1000);
+    }
+    if ((_rcvd_numof == (int)sizeof(_rcvd)) &&
+        (memcmp(_rcvd, _data, sizeof(_data)) == 0)) {
+        printf("received %d bytes in order\n", _rcvd_numof);
+    }
+    else {
+        printf("received %d bytes, data corrupted\n", _rcvd_numof);
+        success = false;
+    }
+    puts(success ? "SUCCESS" : "FAILED");
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("connection established")
+    child.expect_exact("SACK after segment 1: [1065, 1129)")
+    child.expect_exact("SACK after segment 3: [1193, 1257) [1065, 1129)")
+    child.expect_exact("SACK after segment 2: [1065, 1257)")
+    child.expect_exact("ACK after segment 0: 1257")
+    child.expect_exact("received 256 bytes in order")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the bulk transfer throughput of GNRC TCP
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#define CHUNK_SIZE      (1024U)
+
+static uint8_t _buf[CHUNK_SIZE];
+
+static inline uint8_t _pattern(uint32_t pos)
+{
+    return (uint8_t)(pos ^ (pos >> 8));
+}
+
+#if TCP_SERVER
+/* "ifconfig" shell command */
+extern int _gnrc_netif_config(int argc, char **argv);
+
+static int _run(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_netif_t *netif;
+    uint32_t rcvd = 0;
+    int res;
+
+    if (!(netif = gnrc_netif_iter(NULL))) {
+        puts("No valid network interface found");
+        return -1;
+    }
+
+    /* Set pre-configured IP address */
+    char if_pid[] = { netif->pid + '0', '\0' };
+    char *cmd[] = { "ifconfig", if_pid, "add", "unicast", SERVER_ADDR };
+    _gnrc_netif_config(5, cmd);
+
+    printf("Waiting for client: SERVER_ADDR=%s, PORT=%d\n", SERVER_ADDR,
+           TARGET_PORT);
+    if ((res = gnrc_tcp_open_passive(tcb, AF_INET6, NULL, TARGET_PORT)) < 0) {
+        printf("gnrc_tcp_open_passive() : %d\n", res);
+        return -1;
+    }
+    while (rcvd < NBYTE) {
+        res = gnrc_tcp_recv(tcb, _buf, sizeof(_buf),
+                            GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        if (res == -EAGAIN) {
+            continue;
+        }
+        if (res < 0) {
+            printf("gnrc_tcp_recv() : %d\n", res);
+            return -1;
+        }
+        for (int i = 0; i < res; i++) {
+            if (_buf[i] != _pattern(rcvd + i)) {
+                printf("Payload verification failed at byte %lu\n",
+                       (unsigned long)(rcvd + i));
+                return -1;
+            }
+        }
+        rcvd += res;
+    }
+    printf("Received %lu bytes\n", (unsigned long)rcvd);
+    return 0;
+}
+#else
+static int _run(gnrc_tcp_tcb_t *tcb)
+{
+    char target_addr[] = TARGET_ADDR;
+    uint32_t sent = 0, start, duration;
+    int res;
+
+    printf("Connecting: TARGET_ADDR=%s, PORT=%d, NBYTE=%d\n", TARGET_ADDR,
+           TARGET_PORT, NBYTE);
+    if ((res = gnrc_tcp_open_active(tcb, AF_INET6, target_addr, TARGET_PORT,
+                                    0)) < 0) {
+        printf("gnrc_tcp_open_active() : %d\n", res);
+        return -1;
+    }
+    start = xtimer_now_usec();
+    while (sent < NBYTE) {
+        size_t len = sizeof(_buf);
+        int chunk;
+
+        if ((NBYTE - sent) < len) {
+            len = NBYTE - sent;
+        }
+        for (unsigned i = 0; i < len; i++) {
+            _buf[i] = _pattern(sent + i);
+        }
+        /* gnrc_tcp_send() may return after queueing only a part of a chunk */
+        for (chunk = 0; chunk < (int)len; chunk += res) {
+            res = gnrc_tcp_send(tcb, _buf + chunk, len - chunk, 0);
+            if (res < 0) {
+                printf("gnrc_tcp_send() : %d\n", res);
+                return -1;
+            }
+        }
+        sent += len;
+    }
+    /* closing waits until all data was acknowledged by the peer */
+    gnrc_tcp_close(tcb);
+    duration = xtimer_now_usec() - start;
+    printf("{ \"bytes\" : %lu, \"usec\" : %lu, \"kbit/s\" : %lu }\n",
+           (unsigned long)sent, (unsigned long)duration,
+           (unsigned long)(((uint64_t)sent * 8000) / duration));
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    gnrc_tcp_tcb_t tcb;
+
+    gnrc_tcp_tcb_init(&tcb);
+    if (_run(&tcb) < 0) {
+        gnrc_tcp_abort(&tcb);
+        puts("FAILED");
+        return 1;
+    }
+    gnrc_tcp_close(&tcb);
+    puts("SUCCESS");
+
+    return 0;
+}
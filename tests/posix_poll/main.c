@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Serves several UDP sockets from a single thread with poll()
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_PORT           (61616U)
+#define TEST_CLIENT_PORT    (TEST_PORT - 1)
+#define TEST_SERVERS        (3U)
+#define TEST_ROUNDS         (8U)
+#define TEST_TIMEOUT        (1000)  /* in ms */
+#define TEST_SELECT_TIMEOUT (10000U) /* in us */
+
+static char _client_stack[THREAD_STACKSIZE_DEFAULT];
+static volatile bool _client_done = false;
+static volatile bool _client_success = false;
+
+static void _set_addr(struct sockaddr_in6 *addr, uint16_t port)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sin6_family = AF_INET6;
+    addr->sin6_port = htons(port);
+    inet_pton(AF_INET6, "::1", &addr->sin6_addr);
+}
+
+static int _bound_socket(uint16_t port)
+{
+    struct sockaddr_in6 addr;
+    int s = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (s < 0) {
+        return -1;
+    }
+    _set_addr(&addr, port);
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+/* select() has to time out on the idle servers, then report exactly the
+ * server a datagram was sent to as readable */
+static int _test_select(const struct pollfd *fds)
+{
+    struct sockaddr_in6 dst;
+    struct timeval tv = { .tv_sec = 0, .tv_usec = TEST_SELECT_TIMEOUT };
+    fd_set readfds;
+    uint8_t buf[1] = { 0 };
+    int nfds = 0;
+    uint32_t start;
+
+    FD_ZERO(&readfds);
+    for (unsigned i = 0; i < TEST_SERVERS; i++) {
+        FD_SET(fds[i].fd, &readfds);
+        if (fds[i].fd >= nfds) {
+            nfds = fds[i].fd + 1;
+        }
+    }
+    start = xtimer_now_usec();
+    if ((select(nfds, &readfds, NULL, NULL, &tv) != 0) ||
+        ((xtimer_now_usec() - start) < TEST_SELECT_TIMEOUT)) {
+        puts("error: select() did not time out on idle sockets");
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_SERVERS; i++) {
+        if (FD_ISSET(fds[i].fd, &readfds)) {
+            puts("error: select() left an idle socket in the set");
+            return 1;
+        }
+    }
+    puts("select() timed out");
+
+    /* the last server sends to the first one */
+    _set_addr(&dst, TEST_PORT);
+    if (sendto(fds[TEST_SERVERS - 1].fd, buf, sizeof(buf), 0,
+               (struct sockaddr *)&dst, sizeof(dst)) < 0) {
+        puts("error: unable to send to server 0");
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_SERVERS; i++) {
+        FD_SET(fds[i].fd, &readfds);
+    }
+    tv.tv_sec = TEST_TIMEOUT / MS_PER_SEC;
+    tv.tv_usec = 0;
+    if ((select(nfds, &readfds, NULL, NULL, &tv) != 1) ||
+        !FD_ISSET(fds[0].fd, &readfds)) {
+        puts("error: select() did not report server 0 as readable");
+        return 1;
+    }
+    if (recv(fds[0].fd, buf, sizeof(buf), 0) != sizeof(buf)) {
+        puts("error: unable to receive on server 0");
+        return 1;
+    }
+    puts("select() reported readable socket");
+    return 0;
+}
+
+static void *_client(void *arg)
+{
+    int s = _bound_socket(TEST_CLIENT_PORT);
+
+    (void)arg;
+    if (s < 0) {
+        puts("error: unable to create client socket");
+        _client_done = true;
+        return NULL;
+    }
+    _client_success = true;
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        for (unsigned i = 0; i < TEST_SERVERS; i++) {
+            struct sockaddr_in6 dst;
+            uint8_t out[2] = { round, i };
+            uint8_t in[sizeof(out)];
+
+            _set_addr(&dst, TEST_PORT + i);
+            if ((sendto(s, out, sizeof(out), 0, (struct sockaddr *)&dst,
+                        sizeof(dst)) < 0) ||
+                (recv(s, in, sizeof(in), 0) != sizeof(in)) ||
+                (memcmp(in, out, sizeof(out)) != 0)) {
+                printf("error: no echo from server %u in round %u\n", i,
+                       round);
+                _client_success = false;
+            }
+        }
+    }
+    close(s);
+    _client_done = true;
+    return NULL;
+}
+
+int main(void)
+{
+    struct pollfd fds[TEST_SERVERS];
+    unsigned served = 0;
+
+    for (unsigned i = 0; i < TEST_SERVERS; i++) {
+        fds[i].fd = _bound_socket(TEST_PORT + i);
+        fds[i].events = POLLIN;
+        if (fds[i].fd < 0) {
+            puts("error: unable to create server socket");
+            return 1;
+        }
+    }
+    if (poll(fds, TEST_SERVERS, 10) != 0) {
+        puts("error: poll() reported data on idle sockets");
+        return 1;
+    }
+    puts("poll() timed out");
+    if (_test_select(fds) != 0) {
+        return 1;
+    }
+
+    thread_create(_client_stack, sizeof(_client_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _client, NULL, "client");
+    while (!_client_done) {
+        int res = poll(fds, TEST_SERVERS, TEST_TIMEOUT);
+
+        if (res < 0) {
+            puts("error: poll() failed");
+            return 1;
+        }
+        else if (res == 0) {
+            puts("error: poll() timed out while client is active");
+            return 1;
+        }
+        for (unsigned i = 0; i < TEST_SERVERS; i++) {
+            struct sockaddr_in6 src;
+            socklen_t src_len = sizeof(src);
+            uint8_t buf[8];
+            ssize_t len;
+
+            if (!(fds[i].revents & POLLIN)) {
+                continue;
+            }
+            len = recvfrom(fds[i].fd, buf, sizeof(buf), 0,
+                           (struct sockaddr *)&src, &src_len);
+            if ((len < 0) || (sendto(fds[i].fd, buf, len, 0,
+                                     (struct sockaddr *)&src, src_len) < 0)) {
+                printf("error: unable to echo on server %u\n", i);
+                return 1;
+            }
+            served++;
+        }
+    }
+    for (unsigned i = 0; i < TEST_SERVERS; i++) {
+        close(fds[i].fd);
+    }
+    printf("served %u datagrams\n", served);
+    puts((_client_success && (served == (TEST_SERVERS * TEST_ROUNDS))) ?
+         "SUCCESS" : "FAILED");
+
+    return 0;
+}
@@ -11,24 +11,28 @@ from testrunner import run
 
 PS_EXPECTED = (
     ('\tpid | name                 | state    Q | pri | stack  ( used) | '
-     'base addr  | current     | runtime  | switches'),
+     'base addr  | current     | runtime  | switches  | preempt  | '
+     'max burst | irq off'),
     ('\t  - | isr_stack            | -        - |   - | \d+  ( -?\d+) | '
      '0x\d+ | 0x\d+'),
     ('\t  1 | idle                 | pending  Q |  15 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  2 | main                 | running  Q |   7 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  3 | thread               | bl rx    _ |   6 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  4 | thread               | bl rx    _ |   6 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  5 | thread               | bl rx    _ |   6 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  6 | thread               | bl mutex _ |   6 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
     ('\t  7 | thread               | bl rx    _ |   6 | \d+  ( -?\d+) | '
-     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+'),
-    ('\t    | SUM                  |            |     | \d+  (\d+)')
+     '0x\d+ | 0x\d+  | \d+\.\d+% |      \d+ | +\d+ | +\d+ | +\d+'),
+    ('\t    | SUM                  |            |     | \d+  (\d+)'),
+    ('\twakeup latency \[ticks\]'),
+    ('\tpid | +0 +1 +2 +4 +8'),
+    ('\t  1 |( +\d+)+'),
 )
 
 
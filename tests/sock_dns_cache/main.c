@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests caching, coalescing and asynchronous DNS queries
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/dns.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_TTL            (2U)
+#define TEST_SLOW_USEC      (100U * US_PER_MS)
+#define TEST_WAITERS        (3U)
+
+#define NAME_A              "a.test"
+#define NAME_NX             "nx.test"
+#define NAME_NOSOA          "nosoa.test"
+#define NAME_SLOW           "slow.test"
+
+#define FLAGS_REPLY         (0x8180)
+#define RCODE_NXDOMAIN      (3)
+#define TYPE_SOA            (6)
+
+enum {
+    IDX_A = 0,
+    IDX_NX,
+    IDX_NOSOA,
+    IDX_SLOW,
+    IDX_NUMOF,
+};
+
+static const char *_names[IDX_NUMOF] = {
+    NAME_A, NAME_NX, NAME_NOSOA, NAME_SLOW
+};
+static const ipv6_addr_t _addr = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                           0, 0, 0, 0, 0, 0, 0, 0x01 } };
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static char _waiter_stacks[TEST_WAITERS][THREAD_STACKSIZE_DEFAULT];
+static unsigned _queries[IDX_NUMOF];
+static uint16_t _last_id;
+static unsigned _same_ids;
+static unsigned _done, _failed;
+
+static size_t _put_rr_hdr(uint8_t *buf, uint16_t type, uint16_t rdlen)
+{
+    /* name is a pointer to the question, class IN */
+    uint8_t hdr[] = { 0xc0, sizeof(sock_dns_hdr_t), type >> 8, type & 0xff,
+                      0, DNS_CLASS_IN, 0, 0, 0, TEST_TTL,
+                      rdlen >> 8, rdlen & 0xff };
+
+    memcpy(buf, hdr, sizeof(hdr));
+    return sizeof(hdr);
+}
+
+/* decodes the name of the first question into a dotted string */
+static int _get_name(const uint8_t *buf, size_t len, char *name)
+{
+    const uint8_t *pos = buf + sizeof(sock_dns_hdr_t);
+    char *out = name;
+
+    while ((pos < (buf + len)) && *pos) {
+        if ((pos + *pos + 1) > (buf + len) ||
+            ((out - name) + *pos + 1) > SOCK_DNS_MAX_NAME_LEN) {
+            return -1;
+        }
+        if (out != name) {
+            *out++ = '.';
+        }
+        memcpy(out, pos + 1, *pos);
+        out += *pos;
+        pos += *pos + 1;
+    }
+    *out = '\0';
+    /* skip terminating zero, type and class */
+    return (pos + 5) - buf;
+}
+
+static void *_server_thread(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SOCK_DNS_PORT };
+    sock_udp_ep_t remote;
+    sock_udp_t sock;
+    uint8_t buf[128];
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+
+    (void)arg;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("error: unable to open server sock");
+        return NULL;
+    }
+    while (1) {
+        sock_dns_hdr_t *hdr = (sock_dns_hdr_t *)buf;
+        ssize_t len = sock_udp_recv(&sock, buf, sizeof(buf), SOCK_NO_TIMEOUT,
+                                    &remote);
+        uint16_t flags = FLAGS_REPLY;
+        uint8_t *pos;
+        int idx;
+
+        if ((len <= (ssize_t)sizeof(sock_dns_hdr_t)) ||
+            ((len = _get_name(buf, len, name)) < 0) ||
+            ((len + 10 + 22) > (ssize_t)sizeof(buf))) {
+            continue;
+        }
+        for (idx = 0; idx < IDX_NUMOF; idx++) {
+            if (strcmp(name, _names[idx]) == 0) {
+                break;
+            }
+        }
+        if (idx == IDX_NUMOF) {
+            continue;
+        }
+        _queries[idx]++;
+        if (hdr->id == _last_id) {
+            _same_ids++;
+        }
+        _last_id = hdr->id;
+
+        /* answer with the question only */
+        pos = buf + len;
+        hdr->qdcount = htons(1);
+        hdr->ancount = 0;
+        hdr->nscount = 0;
+        hdr->arcount = 0;
+        switch (idx) {
+            case IDX_SLOW:
+                xtimer_usleep(TEST_SLOW_USEC);
+                /* fall through */
+            case IDX_A:
+                hdr->ancount = htons(1);
+                pos += _put_rr_hdr(pos, DNS_TYPE_AAAA, sizeof(_addr));
+                memcpy(pos, &_addr, sizeof(_addr));
+                pos += sizeof(_addr);
+                break;
+            case IDX_NX:
+                /* empty MNAME and RNAME, SERIAL, REFRESH, RETRY, EXPIRE and
+                 * MINIMUM */
+                hdr->nscount = htons(1);
+                pos += _put_rr_hdr(pos, TYPE_SOA, 22);
+                memset(pos, 0, 22);
+                pos[21] = TEST_TTL;
+                pos += 22;
+                /* fall through */
+            case IDX_NOSOA:
+                flags |= RCODE_NXDOMAIN;
+                break;
+        }
+        hdr->flags = htons(flags);
+        /* a spoofed reply first, which the client has to ignore */
+        hdr->id ^= 0xffff;
+        sock_udp_send(&sock, buf, pos - buf, &remote);
+        hdr->id ^= 0xffff;
+        sock_udp_send(&sock, buf, pos - buf, &remote);
+    }
+    return NULL;
+}
+
+static int _expect(const char *name, int exp_res, unsigned exp_queries)
+{
+    ipv6_addr_t addr;
+    int idx, res = sock_dns_query(name, &addr, AF_INET6);
+
+    for (idx = 0; strcmp(name, _names[idx]) != 0; idx++) {}
+    if ((res != exp_res) ||
+        ((res > 0) && !ipv6_addr_equal(&addr, &_addr))) {
+        printf("error: unexpected result for %s (%d)\n", name, res);
+        return 1;
+    }
+    if (_queries[idx] != exp_queries) {
+        printf("error: %u queries for %s, expected %u\n", _queries[idx], name,
+               exp_queries);
+        return 1;
+    }
+    return 0;
+}
+
+static void _check_slow(int res, const void *addr)
+{
+    if ((res != sizeof(ipv6_addr_t)) || !ipv6_addr_equal(addr, &_addr)) {
+        _failed++;
+    }
+    _done++;
+}
+
+static void *_waiter_thread(void *arg)
+{
+    ipv6_addr_t addr;
+
+    (void)arg;
+    _check_slow(sock_dns_query(NAME_SLOW, &addr, AF_INET6), &addr);
+    return NULL;
+}
+
+static void _async_cb(sock_dns_async_t *req, int res)
+{
+    _check_slow(res, req->addr);
+}
+
+int main(void)
+{
+    sock_dns_async_t req;
+
+    sock_dns_server.family = AF_INET6;
+    sock_dns_server.port = SOCK_DNS_PORT;
+    ipv6_addr_set_loopback((ipv6_addr_t *)&sock_dns_server.addr.ipv6);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, 0, _server_thread, NULL, "server");
+
+    /* answers are cached until their TTL expires */
+    if (_expect(NAME_A, sizeof(ipv6_addr_t), 1) ||
+        _expect(NAME_A, sizeof(ipv6_addr_t), 1) ||
+        _expect(NAME_NX, -1, 1) ||
+        _expect(NAME_NX, -1, 1) ||
+        _expect(NAME_NOSOA, -1, 1) ||
+        _expect(NAME_NOSOA, -1, 2)) {
+        return 1;
+    }
+    xtimer_usleep((TEST_TTL * US_PER_SEC) + (100U * US_PER_MS));
+    if (_expect(NAME_A, sizeof(ipv6_addr_t), 2) ||
+        _expect(NAME_NX, -1, 2)) {
+        return 1;
+    }
+    if (_same_ids > 0) {
+        puts("error: query ID reused");
+        return 1;
+    }
+
+    /* the waiters have a higher priority than main, so they all ask before
+     * the first reply arrives */
+    for (unsigned i = 0; i < TEST_WAITERS; i++) {
+        thread_create(_waiter_stacks[i], sizeof(_waiter_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, 0, _waiter_thread, NULL,
+                      "waiter");
+    }
+    if (sock_dns_query_async(&req, NAME_SLOW, AF_INET6, _async_cb) != 0) {
+        puts("error: unable to start asynchronous query");
+        return 1;
+    }
+    while (_done < (TEST_WAITERS + 1)) {
+        xtimer_usleep(10U * US_PER_MS);
+    }
+    if ((_failed > 0) || (_queries[IDX_SLOW] != 1)) {
+        printf("error: %u failed lookups, %u queries for %s\n", _failed,
+               _queries[IDX_SLOW], NAME_SLOW);
+        return 1;
+    }
+
+    /* cached answers are passed to the callback right away */
+    _done = 0;
+    if ((sock_dns_query_async(&req, NAME_SLOW, AF_INET6, _async_cb) != 0) ||
+        (_done != 1) || (_failed > 0)) {
+        puts("error: asynchronous query not answered from cache");
+        return 1;
+    }
+
+    puts("SUCCESS");
+
+    return 0;
+}
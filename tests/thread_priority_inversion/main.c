@@ -27,7 +27,10 @@
 #include "mutex.h"
 #include "xtimer.h"
 
+#define TIMEOUT_USEC    (100U * US_PER_MS)
+
 mutex_t res_mtx;
+mutex_t timeout_mtx;
 
 char stack_high[THREAD_STACKSIZE_DEFAULT];
 char stack_mid[THREAD_STACKSIZE_DEFAULT];
@@ -85,16 +88,57 @@ void *t_high_handler(void *arg)
     return NULL;
 }
 
+void *t_timeout_handler(void *arg)
+{
+    (void) arg;
+
+    if (xtimer_mutex_lock_timeout(&timeout_mtx, TIMEOUT_USEC) == 0) {
+        puts("t_timeout: error: got resource");
+        mutex_unlock(&timeout_mtx);
+    }
+    return NULL;
+}
+
 kernel_pid_t pid_low;
 kernel_pid_t pid_mid;
 kernel_pid_t pid_high;
 
+/* main holds timeout_mtx while a thread of higher priority waits for it
+ * until it times out, after which main has to run at its own priority
+ * again */
+static void test_timeout(void)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    mutex_init(&timeout_mtx);
+    mutex_lock(&timeout_mtx);
+    /* t_high is not started yet, so its stack is borrowed */
+    thread_create(stack_high, sizeof(stack_high),
+        THREAD_PRIORITY_MAIN - 3,
+        THREAD_CREATE_STACKTEST,
+        t_timeout_handler, NULL,
+        "t_timeout");
+    if (me->priority != THREAD_PRIORITY_MAIN - 3) {
+        puts("main: error: not boosted by waiter");
+    }
+    xtimer_usleep(2 * TIMEOUT_USEC);
+    if (me->priority != THREAD_PRIORITY_MAIN) {
+        puts("main: error: still boosted after waiter timed out");
+    }
+    else {
+        puts("main: priority restored after waiter timed out");
+    }
+    mutex_unlock(&timeout_mtx);
+}
+
 int main(void)
 {
     xtimer_init();
     mutex_init(&res_mtx);
     puts("This is a scheduling test for Priority Inversion");
 
+    test_timeout();
+
     pid_low = thread_create(stack_low, sizeof(stack_low),
         THREAD_PRIORITY_MAIN - 1,
         THREAD_CREATE_STACKTEST,
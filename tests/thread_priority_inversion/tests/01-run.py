@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("This is a scheduling test for Priority Inversion")
+    child.expect_exact("main: priority restored after waiter timed out")
+    child.expect_exact("t_mid: doing some stupid stuff...")
+    # without priority inheritance t_high starves from here on
+    for _ in range(3):
+        child.expect_exact("t_high: got resource.", timeout=10)
+        child.expect_exact("t_high: freed resource.", timeout=10)
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
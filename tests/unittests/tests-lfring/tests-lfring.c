@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "lfring.h"
+
+#define BUF_SIZE    (8U)
+
+static uint8_t _buf[BUF_SIZE];
+static void *_ptr_buf[BUF_SIZE];
+static lfring_mpsc_slot_t _slots[BUF_SIZE];
+
+static lfring_t _rb;
+static lfring_ptr_t _ptr_rb;
+static lfring_mpsc_t _mpsc_rb;
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    lfring_init(&_rb, _buf, sizeof(_buf));
+    lfring_ptr_init(&_ptr_rb, _ptr_buf, BUF_SIZE);
+    lfring_mpsc_init(&_mpsc_rb, _slots, BUF_SIZE);
+}
+
+static void test_lfring_one(void)
+{
+    TEST_ASSERT_EQUAL_INT(1, lfring_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, lfring_get_one(&_rb));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, lfring_add_one(&_rb, 0xf0 + i));
+    }
+    TEST_ASSERT_EQUAL_INT(1, lfring_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, lfring_add_one(&_rb, 0));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xf0 + i, lfring_get_one(&_rb));
+    }
+    TEST_ASSERT_EQUAL_INT(1, lfring_empty(&_rb));
+}
+
+static void test_lfring_bulk_wrap(void)
+{
+    static const uint8_t data[] = "0123456789";
+    uint8_t out[sizeof(data)];
+
+    /* move read and write position to the middle */
+    TEST_ASSERT_EQUAL_INT(5, lfring_add(&_rb, data, 5));
+    TEST_ASSERT_EQUAL_INT(5, lfring_drop(&_rb, 5));
+
+    /* wraps around the end of the buffer, only BUF_SIZE fit */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfring_add(&_rb, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, lfring_free(&_rb));
+    TEST_ASSERT_EQUAL_INT(3, lfring_get(&_rb, out, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, data, 3));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 3, lfring_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &data[3], BUF_SIZE - 3));
+    TEST_ASSERT_EQUAL_INT(0, lfring_get(&_rb, out, sizeof(out)));
+}
+
+static void test_lfring_peek_commit(void)
+{
+    uint8_t *wptr;
+    const uint8_t *rptr;
+
+    TEST_ASSERT_EQUAL_INT(6, lfring_add(&_rb, "abcdef", 6));
+    TEST_ASSERT_EQUAL_INT(4, lfring_drop(&_rb, 4));
+
+    /* only the span up to the end of the buffer is returned */
+    TEST_ASSERT_EQUAL_INT(2, lfring_write_peek(&_rb, &wptr));
+    TEST_ASSERT(wptr == &_buf[6]);
+    memcpy(wptr, "gh", 2);
+    lfring_write_commit(&_rb, 2);
+    TEST_ASSERT_EQUAL_INT(4, lfring_write_peek(&_rb, &wptr));
+    TEST_ASSERT(wptr == &_buf[0]);
+    memcpy(wptr, "i", 1);
+    lfring_write_commit(&_rb, 1);
+
+    TEST_ASSERT_EQUAL_INT(4, lfring_read_peek(&_rb, &rptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rptr, "efgh", 4));
+    lfring_read_commit(&_rb, 4);
+    TEST_ASSERT_EQUAL_INT(1, lfring_read_peek(&_rb, &rptr));
+    TEST_ASSERT_EQUAL_INT('i', *rptr);
+    lfring_read_commit(&_rb, 1);
+    TEST_ASSERT_EQUAL_INT(0, lfring_read_peek(&_rb, &rptr));
+}
+
+static void test_lfring_ptr(void)
+{
+    void *in[BUF_SIZE + 1], *out[BUF_SIZE + 1];
+    void *const *span;
+    void *p;
+
+    for (unsigned i = 0; i <= BUF_SIZE; i++) {
+        in[i] = &in[i];
+    }
+    TEST_ASSERT_EQUAL_INT(0, lfring_ptr_add_one(&_ptr_rb, in[0]));
+    TEST_ASSERT_EQUAL_INT(0, lfring_ptr_get_one(&_ptr_rb, &p));
+    TEST_ASSERT(p == in[0]);
+    TEST_ASSERT_EQUAL_INT(-1, lfring_ptr_get_one(&_ptr_rb, &p));
+
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE,
+                          lfring_ptr_add(&_ptr_rb, in, BUF_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 1, lfring_ptr_read_peek(&_ptr_rb, &span));
+    TEST_ASSERT(span[0] == in[0]);
+    lfring_ptr_read_commit(&_ptr_rb, 1);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 1,
+                          lfring_ptr_get(&_ptr_rb, out, BUF_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &in[1], (BUF_SIZE - 1) * sizeof(void *)));
+}
+
+static void test_lfring_mpsc(void)
+{
+    int vals[BUF_SIZE];
+    void *out[BUF_SIZE];
+    void *p;
+
+    TEST_ASSERT_EQUAL_INT(-1, lfring_mpsc_get_one(&_mpsc_rb, &p));
+    for (unsigned round = 0; round < 3; round++) {
+        for (unsigned i = 0; i < BUF_SIZE; i++) {
+            TEST_ASSERT_EQUAL_INT(0, lfring_mpsc_add(&_mpsc_rb, &vals[i]));
+        }
+        TEST_ASSERT_EQUAL_INT(-1, lfring_mpsc_add(&_mpsc_rb, &vals[0]));
+        TEST_ASSERT_EQUAL_INT(0, lfring_mpsc_get_one(&_mpsc_rb, &p));
+        TEST_ASSERT(p == &vals[0]);
+        TEST_ASSERT_EQUAL_INT(BUF_SIZE - 1,
+                              lfring_mpsc_get(&_mpsc_rb, out, BUF_SIZE));
+        TEST_ASSERT(out[BUF_SIZE - 2] == &vals[BUF_SIZE - 1]);
+    }
+}
+
+Test *tests_lfring_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_lfring_one),
+        new_TestFixture(test_lfring_bulk_wrap),
+        new_TestFixture(test_lfring_peek_commit),
+        new_TestFixture(test_lfring_ptr),
+        new_TestFixture(test_lfring_mpsc),
+    };
+
+    EMB_UNIT_TESTCALLER(lfring_tests, set_up, NULL, fixtures);
+
+    return (Test *)&lfring_tests;
+}
+
+void tests_lfring(void)
+{
+    TESTS_RUN(tests_lfring_tests());
+}
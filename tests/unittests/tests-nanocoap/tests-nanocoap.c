@@ -250,6 +250,61 @@ static void test_nanocoap__get_path_too_long(void)
     TEST_ASSERT_EQUAL_INT(-ENOSPC, get_len);
 }
 
+/*
+ * Resources for the find_resource test, ordered by path. Handlers are not
+ * called, so they are NULL.
+ */
+static const coap_resource_t _find_resources[] = {
+    { "/", COAP_GET, NULL, NULL },
+    { "/3", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/3/0", COAP_PUT, NULL, NULL },
+    { "/3/0/1", COAP_GET, NULL, NULL },
+    { "/3/0/1", COAP_POST, NULL, NULL },
+    { "/34", COAP_GET, NULL, NULL },
+    { "/cli/stats", COAP_GET, NULL, NULL },
+};
+
+/*
+ * Looks up exact paths and paths below subtree resources with
+ * coap_find_resource().
+ */
+static void test_nanocoap__find_resource(void)
+{
+    const coap_resource_t *res = NULL;
+    size_t numof = sizeof(_find_resources) / sizeof(_find_resources[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof, "/",
+                                                COAP_GET, &res));
+    TEST_ASSERT(res == &_find_resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof,
+                                                "/cli/stats", COAP_GET, &res));
+    TEST_ASSERT(res == &_find_resources[6]);
+    /* second resource with the same path */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof,
+                                                "/3/0/1", COAP_POST, &res));
+    TEST_ASSERT(res == &_find_resources[4]);
+    /* exact path preferred over subtree */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof,
+                                                "/34", COAP_GET, &res));
+    TEST_ASSERT(res == &_find_resources[5]);
+    /* below subtree, also where the exact path has the wrong method */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof,
+                                                "/3/1/2", COAP_GET, &res));
+    TEST_ASSERT(res == &_find_resources[1]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(_find_resources, numof,
+                                                "/3/0", COAP_GET, &res));
+    TEST_ASSERT(res == &_find_resources[1]);
+    /* only exact paths for resources not flagged as subtree */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(_find_resources, numof,
+                                                      "/cli/stats/0", COAP_GET,
+                                                      &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(_find_resources, numof,
+                                                      "/345", COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, coap_find_resource(_find_resources, numof,
+                                                       "/3/0/1", COAP_DELETE,
+                                                       &res));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -261,6 +316,7 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__get_root_path),
         new_TestFixture(test_nanocoap__get_max_path),
         new_TestFixture(test_nanocoap__get_path_too_long),
+        new_TestFixture(test_nanocoap__find_resource),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
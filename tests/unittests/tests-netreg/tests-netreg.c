@@ -23,7 +23,8 @@
 
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
-    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1, TEST_UINT8 + 2)
 };
 
 static void set_up(void)
@@ -139,6 +140,40 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup_num__empty(void)
+{
+    int num = -1;
+
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_NUMOF, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+void test_netreg_lookup_num__interleaved(void)
+{
+    gnrc_netreg_entry_t *res;
+    int num = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[2]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16, &num)));
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT_EQUAL_INT(TEST_UINT16, res->demux_ctx);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT16, res->demux_ctx);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT(&entries[2] == gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + 1, &num));
+    TEST_ASSERT_EQUAL_INT(1, num);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[0]);
+    TEST_ASSERT(&entries[1] == gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(1, num);
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +190,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup_num__empty),
+        new_TestFixture(test_netreg_lookup_num__interleaved),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
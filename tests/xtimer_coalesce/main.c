@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_coalesce test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_TIMERS     (8U)
+#define BASE_OFFSET     (100U * US_PER_MS)
+#define SPACING         (2U * US_PER_MS)
+#define SLACK           (TEST_TIMERS * SPACING)
+
+static xtimer_t _timers[TEST_TIMERS];
+static uint32_t _targets[TEST_TIMERS];
+static uint32_t _fired_at[TEST_TIMERS];
+static kernel_pid_t _main_pid;
+
+static void _cb(void *arg)
+{
+    unsigned i = (unsigned)(uintptr_t)arg;
+
+    _fired_at[i] = xtimer_now_usec();
+    if (i == (TEST_TIMERS - 1)) {
+        thread_wakeup(_main_pid);
+    }
+}
+
+int main(void)
+{
+    xtimer_coalesce_stats_t before, after;
+    unsigned early = 0;
+
+    puts("xtimer_coalesce test");
+    _main_pid = thread_getpid();
+
+    xtimer_coalesce_stats(&before);
+    uint32_t now = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_TIMERS; i++) {
+        _timers[i].callback = _cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+        _targets[i] = now + BASE_OFFSET + (i * SPACING);
+        /* all windows overlap with the last timer's target */
+        xtimer_set_slack(&_timers[i], BASE_OFFSET + (i * SPACING), SLACK);
+    }
+    thread_sleep();
+    xtimer_coalesce_stats(&after);
+
+    for (unsigned i = 0; i < TEST_TIMERS; i++) {
+        if ((int32_t)(_fired_at[i] - _targets[i]) < 0) {
+            printf("timer %u fired early\n", i);
+            early++;
+        }
+    }
+
+    unsigned sweeps = after.sweeps - before.sweeps;
+    unsigned fired = after.fired - before.fired;
+    printf("fired: %u, sweeps: %u, coalesced: %u\n", fired, sweeps,
+           fired - sweeps);
+
+    if (!early && (fired == TEST_TIMERS) && (sweeps < TEST_TIMERS)) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+
+    return 0;
+}